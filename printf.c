@@ -44,15 +44,16 @@
 #endif
 
 
-// 'ntoa' conversion buffer size, this must be big enough to hold one converted
-// numeric number including padded zeros (dynamically created on stack)
+// 'ntoa' conversion buffer size, this must be big enough to hold the digits of one
+// converted number, padded zeros aren't buffered (dynamically created on stack)
 // default: 32 byte
 #ifndef PRINTF_NTOA_BUFFER_SIZE
 #define PRINTF_NTOA_BUFFER_SIZE    32U
 #endif
 
-// 'ftoa' conversion buffer size, this must be big enough to hold one converted
-// float number including padded zeros (dynamically created on stack)
+// 'ftoa' conversion buffer size, this must be big enough to hold the digits of the integer part
+// of a converted float number up to 2^64 (at least 20), longer numbers and fractions are converted
+// in groups of 9 digits, padded zeros aren't buffered (dynamically created on stack)
 // default: 32 byte
 #ifndef PRINTF_FTOA_BUFFER_SIZE
 #define PRINTF_FTOA_BUFFER_SIZE    32U
@@ -64,6 +65,14 @@
 #define PRINTF_SUPPORT_FLOAT
 #endif
 
+// support for single precision %hf: the double argument is rounded to float and converted on its
+// IEEE-754 bits with 32-bit integer math, so no double operations are used (e.g. a Cortex-M4F
+// without a double FPU). float arguments of the C++ front end are converted without the promotion
+// default: activated
+#ifndef PRINTF_DISABLE_SUPPORT_FLOAT32
+#define PRINTF_SUPPORT_FLOAT32
+#endif
+
 // support for exponential floating point notation (%e/%g)
 // default: activated
 #ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
@@ -76,10 +85,17 @@
 #define PRINTF_DEFAULT_FLOAT_PRECISION  6U
 #endif
 
-// define the largest float suitable to print with %f
-// default: 1e9
-#ifndef PRINTF_MAX_FLOAT
-#define PRINTF_MAX_FLOAT  1e9
+// support for the shortest round-trip floating point notation (%r)
+// default: activated
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP
+#define PRINTF_SUPPORT_ROUNDTRIP
+#endif
+
+// support for %r of double values, its tables take about 10 kbyte. Without it %r prints the shortest
+// notation which round-trips as float, like %hr (tables of 630 byte)
+// default: activated
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP_DOUBLE
+#define PRINTF_SUPPORT_ROUNDTRIP_DOUBLE
 #endif
 
 // support for the long long types (%llu or %p)
@@ -88,6 +104,42 @@
 #define PRINTF_SUPPORT_LONG_LONG
 #endif
 
+// block output through _putchars() instead of one _putchar() call per character,
+// define this globally (e.g. gcc -DPRINTF_SUPPORT_PUTCHARS ...) if you provide _putchars()
+// default: undefined
+
+// non-blocking try_printf() and try_vprintf(), which drop a line instead of waiting for the console,
+// define this globally (e.g. gcc -DPRINTF_SUPPORT_TRY_PRINTF ...) if you provide _putchar_room()
+// default: undefined
+
+// drop report, which try_printf() outputs in front of the next line that fits, %u is the number
+// of dropped lines
+// default: "[%u dropped]\n"
+#ifndef PRINTF_TRY_DROPPED_FORMAT
+#define PRINTF_TRY_DROPPED_FORMAT  "[%u dropped]\n"
+#endif
+
+// size check of sprintf_sized() and vsprintf_sized(), which measure the output once per call and
+// assert() that it fits, define this globally (e.g. gcc -DPRINTF_SPRINTF_SIZED_CHECK ...) for debug
+// builds with a hosted <assert.h>
+// default: undefined
+#if defined(PRINTF_SPRINTF_SIZED_CHECK)
+#include <assert.h>
+#endif
+
+// dedicated conversion paths which trade ROM for speed, e.g. the two digits per
+// step base 10 integer conversion with its 200 byte digit pair table
+// default: undefined
+
+// own copies of the format engine for the buffer (sprintf_, sn/vsnprintf_) and _putchar() (printf_, vprintf_) output, with
+// GCC or clang everything is inlined into them, so the output is no call through a function pointer but the stores
+// or the _putchar() call itself, at the cost of three more engine copies in ROM (PRINTF_SPECIALIZE_OUTPUT)
+// default: undefined
+
+// exponential notation (%e/%g) with integer math only, exactly rounded like %f, instead of the
+// double arithmetic of the default conversion, for targets without FPU (PRINTF_FLOAT_INTEGER_ONLY)
+// default: undefined
+
 // support for the ptrdiff_t type (%t)
 // ptrdiff_t is normally defined in <stddef.h> as long or long long type
 // default: activated
@@ -95,6 +147,32 @@
 #define PRINTF_SUPPORT_PTRDIFF_T
 #endif
 
+// support for deferred (binary) logging, encoding the format pointer and the raw
+// arguments into a record which is formatted later on the host
+// default: activated
+#ifndef PRINTF_DISABLE_SUPPORT_BINARY
+#define PRINTF_SUPPORT_BINARY
+#endif
+
+// support for SIMD (SSE2 or NEON) scanning of literal format text and 64-bit hex
+// conversion, used if the target provides it, otherwise a portable word-at-a-time
+// (SWAR) scan and the shift/mask hex conversion are used
+// default: activated
+#ifndef PRINTF_DISABLE_SUPPORT_SIMD
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define PRINTF_SUPPORT_SIMD
+#endif
+#endif
+
+// support for the lock-free multi-producer ring buffer output (printf_ring()), which uses the
+// __atomic builtins of GCC and clang (on ARMv6-M these need libatomic, disable it there)
+// default: activated (GCC and clang)
+#ifndef PRINTF_DISABLE_SUPPORT_RING
+#if defined(__GNUC__)
+#define PRINTF_SUPPORT_RING
+#endif
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // internal flag definitions
@@ -110,6 +188,8 @@
 #define FLAGS_LONG_LONG (1U <<  9U)
 #define FLAGS_PRECISION (1U << 10U)
 #define FLAGS_ADAPT_EXP (1U << 11U)
+#define FLAGS_WIDTH_ARG (1U << 12U)
+#define FLAGS_PRECISION_ARG (1U << 13U)
 
 
 // import float.h for DBL_MAX
@@ -118,8 +198,19 @@
 #endif
 
 
-// output function type
-typedef void (*out_fct_type)(char character, void* buffer, size_t idx, size_t maxlen);
+// import the SIMD intrinsics for the literal text scanner and the hex conversion
+#if defined(PRINTF_SUPPORT_SIMD)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+
+// output function type, called with a span of 'len' characters to be placed at 'idx'
+// the output is terminated by a call with data == NULL
+typedef void (*out_fct_type)(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen);
 
 
 // wrapper (used as buffer) for output function type
@@ -129,39 +220,107 @@ typedef struct {
 } out_fct_wrap_type;
 
 
+// wrapper (used as buffer) for span output function type
+typedef struct {
+  void  (*fct)(const char* data, size_t len, void* arg);
+  void* arg;
+} out_span_wrap_type;
+
+
+// the engine instances of PRINTF_SPECIALIZE_OUTPUT have everything inlined, except the floating point and
+// fixed point conversions, which are dominated by their arithmetic and stay shared with an out() call each, and
+// the measuring of a NULL buffer
+#if defined(PRINTF_SPECIALIZE_OUTPUT) && defined(__GNUC__)
+#define PRINTF_ENGINE_INSTANCE  static __attribute__((flatten, noinline))
+#define PRINTF_ENGINE_SHARED    __attribute__((noinline))
+#else
+#define PRINTF_ENGINE_INSTANCE  static
+#define PRINTF_ENGINE_SHARED
+#endif
+
+
 // internal buffer output
-static inline void _out_buffer(char character, void* buffer, size_t idx, size_t maxlen)
+static inline void _out_buffer(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
 {
   if (idx < maxlen) {
-    ((char*)buffer)[idx] = character;
+    if (!data) {
+      // termination
+      ((char*)buffer)[idx] = 0;
+      return;
+    }
+    if (len > maxlen - idx) {
+      len = maxlen - idx;
+    }
+    char* dst = (char*)buffer + idx;
+    while (len--) {
+      *dst++ = *data++;
+    }
+  }
+}
+
+
+// internal buffer output without bounds check, for buffers which are known to be big enough (sprintf_(),
+// sprintf_sized()), so there is no per character compare against 'maxlen'
+static inline void _out_buffer_unbounded(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
+{
+  (void)maxlen;
+  char* dst = (char*)buffer + idx;
+  if (!data) {
+    // termination
+    *dst = 0;
+    return;
+  }
+  while (len--) {
+    *dst++ = *data++;
   }
 }
 
 
 // internal null output
-static inline void _out_null(char character, void* buffer, size_t idx, size_t maxlen)
+static inline void _out_null(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
 {
-  (void)character; (void)buffer; (void)idx; (void)maxlen;
+  (void)data; (void)len; (void)buffer; (void)idx; (void)maxlen;
 }
 
 
 // internal _putchar wrapper
-static inline void _out_char(char character, void* buffer, size_t idx, size_t maxlen)
+#if defined(PRINTF_SUPPORT_PUTCHARS)
+static inline void _out_char(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
+{
+  (void)buffer; (void)idx; (void)maxlen;
+  if (len) {
+    _putchars(data, len);
+  }
+}
+#else
+static inline void _out_char(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
 {
   (void)buffer; (void)idx; (void)maxlen;
-  if (character) {
-    _putchar(character);
+  while (len--) {
+    _putchar(*data++);
   }
 }
+#endif
 
 
 // internal output function wrapper
-static inline void _out_fct(char character, void* buffer, size_t idx, size_t maxlen)
+static inline void _out_fct(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
+{
+  (void)idx; (void)maxlen;
+  while (len--) {
+    // buffer is the output fct pointer
+    ((out_fct_wrap_type*)buffer)->fct(*data++, ((out_fct_wrap_type*)buffer)->arg);
+  }
+}
+
+
+// internal span output function wrapper
+static inline void _out_fct_span(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
 {
   (void)idx; (void)maxlen;
-  if (character) {
+  if (len) {
     // buffer is the output fct pointer
-    ((out_fct_wrap_type*)buffer)->fct(character, ((out_fct_wrap_type*)buffer)->arg);
+    ((out_span_wrap_type*)buffer)->fct(data, len, ((out_span_wrap_type*)buffer)->arg);
   }
 }
 
@@ -195,92 +354,452 @@ static unsigned int _atoi(const char** str)
 }
 
 
-// output the specified string in reverse, taking care of any zero-padding
-static size_t _out_rev(out_fct_type out, char* buffer, size_t idx, size_t maxlen, const char* buf, size_t len, unsigned int width, unsigned int flags)
+// word type for the SWAR literal scanner, allowed to alias the format characters
+// the scanners intentionally read beyond the terminating NUL (within an aligned word),
+// so they are excluded from address sanitizing
+#if defined(__GNUC__)
+typedef uintptr_t __attribute__((__may_alias__)) scan_word_type;
+#define PRINTF_NO_SANITIZE_ADDRESS __attribute__((__no_sanitize_address__))
+#else
+typedef uintptr_t scan_word_type;
+#define PRINTF_NO_SANITIZE_ADDRESS
+#endif
+
+
+// internal word-at-a-time scan for the next '%' or the terminating NUL
+// aligned word loads never cross a page boundary, so reading past the NUL is safe
+// \return Pointer to the found character
+PRINTF_NO_SANITIZE_ADDRESS static inline const char* _scan_literal_swar(const char* format)
 {
-  const size_t start_idx = idx;
+  const uintptr_t ones  = (uintptr_t)-1 / 0xFFU;
+  const uintptr_t highs = ones * 0x80U;
+  const uintptr_t pct   = ones * (uintptr_t)'%';
 
-  // pad spaces up to given width
-  if (!(flags & FLAGS_LEFT) && !(flags & FLAGS_ZEROPAD)) {
-    for (size_t i = len; i < width; i++) {
-      out(' ', buffer, idx++, maxlen);
+  // byte steps up to word alignment
+  while ((uintptr_t)format & (sizeof(scan_word_type) - 1U)) {
+    if (!*format || (*format == '%')) {
+      return format;
     }
+    format++;
   }
 
-  // reverse string
-  while (len) {
-    out(buf[--len], buffer, idx++, maxlen);
+  // skip whole words without a zero or a '%' byte
+  const scan_word_type* w = (const scan_word_type*)(const void*)format;
+  for (;;) {
+    const uintptr_t x = *w;
+    const uintptr_t y = x ^ pct;
+    if ((((x - ones) & ~x) | ((y - ones) & ~y)) & highs) {
+      break;
+    }
+    w++;
   }
 
-  // append pad spaces up to given width
-  if (flags & FLAGS_LEFT) {
-    while (idx - start_idx < width) {
-      out(' ', buffer, idx++, maxlen);
+  // locate the character within the word
+  format = (const char*)(const void*)w;
+  while (*format && (*format != '%')) {
+    format++;
+  }
+  return format;
+}
+
+
+#if defined(PRINTF_SUPPORT_SIMD)
+// internal SIMD scan for the next '%' or the terminating NUL
+// loads are 16 byte aligned, so they never cross a page boundary, bytes in front of
+// 'format' are masked out
+// \return Pointer to the found character
+PRINTF_NO_SANITIZE_ADDRESS static inline const char* _scan_literal_simd(const char* format)
+{
+  const size_t offset = (uintptr_t)format & 15U;
+  const char*  p      = format - offset;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i pct  = _mm_set1_epi8('%');
+  __m128i v = _mm_load_si128((const __m128i*)(const void*)p);
+  unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, pct))) >> offset;
+  if (mask) {
+    return format + __builtin_ctz(mask);
+  }
+  for (;;) {
+    p += 16;
+    v = _mm_load_si128((const __m128i*)(const void*)p);
+    mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, pct)));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#else
+  // NEON has no movemask, narrow the compare result to 4 bits per byte instead
+  const uint8x16_t zero = vdupq_n_u8(0U);
+  const uint8x16_t pct  = vdupq_n_u8((uint8_t)'%');
+  uint8x16_t v   = vld1q_u8((const uint8_t*)(const void*)p);
+  uint8x16_t hit = vorrq_u8(vceqq_u8(v, zero), vceqq_u8(v, pct));
+  uint64_t mask  = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0) >> (offset * 4U);
+  if (mask) {
+    return format + (__builtin_ctzll(mask) >> 2);
+  }
+  for (;;) {
+    p  += 16;
+    v   = vld1q_u8((const uint8_t*)(const void*)p);
+    hit = vorrq_u8(vceqq_u8(v, zero), vceqq_u8(v, pct));
+    mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+    if (mask) {
+      return p + (__builtin_ctzll(mask) >> 2);
+    }
+  }
+#endif
+}
+#endif  // PRINTF_SUPPORT_SIMD
+
+
+// internal scan for the end of a literal text run
+// \return Pointer to the next '%' or the terminating NUL
+static inline const char* _scan_literal(const char* format)
+{
+#if defined(PRINTF_SUPPORT_SIMD)
+  return _scan_literal_simd(format);
+#else
+  return _scan_literal_swar(format);
+#endif
+}
+
+
+// output 'count' copies of the character 'chunk' consists of: a fill of the output buffer (memset) for the
+// buffer sinks, spans of the 16 characters of 'chunk' for all other sinks
+static size_t _out_fill(out_fct_type out, char* buffer, size_t idx, size_t maxlen, const char* chunk, size_t count)
+{
+  if ((out == _out_buffer) || (out == _out_buffer_unbounded)) {
+    const size_t room = (out == _out_buffer_unbounded) ? count : (idx < maxlen) ? maxlen - idx : 0U;
+    const size_t len  = count < room ? count : room;
+    for (char* dst = buffer + idx, *end = dst + len; dst != end; ) {
+      *dst++ = *chunk;
     }
+    return idx + count;
+  }
+  while (count) {
+    const size_t len = count < 16U ? count : 16U;
+    out(chunk, len, buffer, idx, maxlen);
+    idx   += len;
+    count -= len;
+  }
+  return idx;
+}
+
+
+// output 'count' spaces
+static size_t _out_spaces(out_fct_type out, char* buffer, size_t idx, size_t maxlen, size_t count)
+{
+  return _out_fill(out, buffer, idx, maxlen, "                ", count);
+}
+
+
+// output 'count' zeros
+static size_t _out_zeros(out_fct_type out, char* buffer, size_t idx, size_t maxlen, size_t count)
+{
+  return _out_fill(out, buffer, idx, maxlen, "0000000000000000", count);
+}
+
+
+// output the head of a number: the space padding, 'prefix' (sign and/or hash prefix) and 'zeros' leading zeros,
+// 'len' is the length of the digits which follow
+static size_t _out_number_head(out_fct_type out, char* buffer, size_t idx, size_t maxlen, const char* prefix, size_t prefix_len, size_t zeros, size_t len, unsigned int width, unsigned int flags)
+{
+  const size_t total = prefix_len + zeros + len;
+  if (!(flags & FLAGS_LEFT) && !(flags & FLAGS_ZEROPAD) && (total < width)) {
+    idx = _out_spaces(out, buffer, idx, maxlen, width - total);
+  }
+  if (prefix_len) {
+    out(prefix, prefix_len, buffer, idx, maxlen);
+    idx += prefix_len;
   }
+  return _out_zeros(out, buffer, idx, maxlen, zeros);
+}
+
 
+// output the tail of a number which began at 'start': the space padding of left aligned numbers
+static size_t _out_number_tail(out_fct_type out, char* buffer, size_t start, size_t idx, size_t maxlen, unsigned int width, unsigned int flags)
+{
+  if ((flags & FLAGS_LEFT) && (idx - start < width)) {
+    idx = _out_spaces(out, buffer, idx, maxlen, width - (idx - start));
+  }
   return idx;
 }
 
 
-// internal itoa format
-static size_t _ntoa_format(out_fct_type out, char* buffer, size_t idx, size_t maxlen, char* buf, size_t len, bool negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
+// internal destination for 'len' characters at 'idx': the output buffer itself if they fit into it,
+// otherwise 'tmp', whose contents the caller sends with out() afterwards
+static inline char* _out_dest(out_fct_type out, char* buffer, size_t idx, size_t maxlen, size_t len, char* tmp)
+{
+  return ((out == _out_buffer_unbounded) || ((out == _out_buffer) && (idx + len <= maxlen))) ? buffer + idx : tmp;
+}
+
+
+// internal powers of 10 for counting decimal digits
+static const unsigned long long _pow10_ull[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+  10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+  10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+
+// internal number of digits of 'value' in base 2, 8, 10 or 16, counted up front without division
+static size_t _ntoa_count(unsigned long long value, unsigned int base)
+{
+#if defined(__GNUC__)
+  const size_t bits = 64U - (size_t)__builtin_clzll(value | 1U);
+#else
+  size_t bits = 1U;
+  while ((bits < 64U) && (value >> bits)) {
+    bits++;
+  }
+#endif
+  if (base == 10U) {
+    // log10 approximated by bits * log10(2), corrected by one table compare
+    const size_t t = (bits * 1233U) >> 12U;
+    return t + (((value | 1U) < _pow10_ull[t]) ? 0U : 1U);
+  }
+  const size_t shift = (base == 16U) ? 4U : ((base == 8U) ? 3U : 1U);
+  return (bits + shift - 1U) / shift;
+}
+
+
+// internal itoa layout: the sign and hash prefix and the number of leading zeros of a number with 'len' digits.
+// A hash prefix which has to take the place of zeros or digits reduces 'len'.
+// \return Length of the prefix
+static size_t _ntoa_layout(char* prefix, size_t* zeros, size_t* len, bool negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
 {
+  size_t prefix_len = 0U;
+  *zeros = 0U;
+
   // pad leading zeros
   if (!(flags & FLAGS_LEFT)) {
     if (width && (flags & FLAGS_ZEROPAD) && (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE)))) {
       width--;
     }
-    while ((len < prec) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-      buf[len++] = '0';
+    if (*len < prec) {
+      *zeros = prec - *len;
     }
-    while ((flags & FLAGS_ZEROPAD) && (len < width) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-      buf[len++] = '0';
+    if ((flags & FLAGS_ZEROPAD) && (*len + *zeros < width)) {
+      *zeros = width - *len;
     }
   }
 
+  // sign
+  if (negative) {
+    prefix[prefix_len++] = '-';
+  }
+  else if (flags & FLAGS_PLUS) {
+    prefix[prefix_len++] = '+';  // ignore the space if the '+' exists
+  }
+  else if (flags & FLAGS_SPACE) {
+    prefix[prefix_len++] = ' ';
+  }
+
   // handle hash
   if (flags & FLAGS_HASH) {
-    if (!(flags & FLAGS_PRECISION) && len && ((len == prec) || (len == width))) {
-      len--;
-      if (len && (base == 16U)) {
-        len--;
-      }
+    size_t drop = 0U;
+    const size_t n = *len + *zeros;
+    if (!(flags & FLAGS_PRECISION) && n && ((n == prec) || (n == width))) {
+      // the prefix replaces leading zeros, or the most significant digits if there are none
+      drop = ((n > 1U) && (base == 16U)) ? 2U : 1U;
     }
-    if ((base == 16U) && !(flags & FLAGS_UPPERCASE) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-      buf[len++] = 'x';
+    if (drop > *zeros) {
+      *len -= drop - *zeros;
+      *zeros = 0U;
     }
-    else if ((base == 16U) && (flags & FLAGS_UPPERCASE) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-      buf[len++] = 'X';
+    else {
+      *zeros -= drop;
     }
-    else if ((base == 2U) && (len < PRINTF_NTOA_BUFFER_SIZE)) {
-      buf[len++] = 'b';
+    prefix[prefix_len++] = '0';
+    if (base == 16U) {
+      prefix[prefix_len++] = (flags & FLAGS_UPPERCASE) ? 'X' : 'x';
     }
-    if (len < PRINTF_NTOA_BUFFER_SIZE) {
-      buf[len++] = '0';
+    else if (base == 2U) {
+      prefix[prefix_len++] = 'b';
     }
   }
 
-  if (len < PRINTF_NTOA_BUFFER_SIZE) {
-    if (negative) {
-      buf[len++] = '-';
-    }
-    else if (flags & FLAGS_PLUS) {
-      buf[len++] = '+';  // ignore the space if the '+' exists
-    }
-    else if (flags & FLAGS_SPACE) {
-      buf[len++] = ' ';
-    }
+  return prefix_len;
+}
+
+
+// internal itoa format, outputs the space padding, sign, hash prefix and leading zeros of a number with 'len'
+// digits. A hash prefix which has to take the place of zeros or digits reduces 'len'.
+static size_t _ntoa_format(out_fct_type out, char* buffer, size_t idx, size_t maxlen, size_t* len, bool negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  char   prefix[3];
+  size_t zeros;
+  const size_t prefix_len = _ntoa_layout(prefix, &zeros, len, negative, base, prec, width, flags);
+  return _out_number_head(out, buffer, idx, maxlen, prefix, prefix_len, zeros, *len, width, flags);
+}
+
+
+// internal length of a number of 'body' characters (prefix, zeros and digits) including its space padding
+static inline size_t _number_len(size_t body, unsigned int width, unsigned int flags)
+{
+  return ((body < width) && ((flags & FLAGS_LEFT) || !(flags & FLAGS_ZEROPAD))) ? width : body;
+}
+
+
+// internal itoa length, the number of characters _ntoa_long()/_ntoa_long_long() output without converting
+static size_t _ntoa_len(unsigned long long value, bool negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  char   prefix[3];
+  size_t zeros;
+  size_t len = 0U;
+
+  // no hash for 0 values
+  if (!value) {
+    flags &= ~FLAGS_HASH;
+  }
+  if (!(flags & FLAGS_PRECISION) || value) {
+    len = _ntoa_count(value, base);
+    len = len < PRINTF_NTOA_BUFFER_SIZE ? len : PRINTF_NTOA_BUFFER_SIZE;
+  }
+  const size_t prefix_len = _ntoa_layout(prefix, &zeros, &len, negative, base, prec, width, flags);
+  return _number_len(prefix_len + zeros + len, width, flags);
+}
+
+
+#if defined(PRINTF_OPTIMIZE_FOR_SPEED)
+// internal table of the decimal digit pairs "00" to "99"
+static const char _digit_pairs[201] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+
+// internal base 10 digits of 'value', 'len' digits are written backwards from 'end',
+// two digits per step with a constant divisor
+static void _dec_long(char* end, unsigned long value, size_t len)
+{
+  while (len >= 2U) {
+    const size_t pair = (size_t)(value % 100U) * 2U;
+    value /= 100U;
+    *--end = _digit_pairs[pair + 1U];
+    *--end = _digit_pairs[pair];
+    len -= 2U;
+  }
+  if (len) {
+    *--end = (char)('0' + value % 10U);
+  }
+}
+
+
+#endif  // PRINTF_OPTIMIZE_FOR_SPEED
+
+
+// internal base 10 digits of a 32-bit 'value', 'len' digits are written backwards from 'end'
+static inline void _dec_uint32(char* end, uint32_t value, size_t len)
+{
+#if defined(PRINTF_OPTIMIZE_FOR_SPEED)
+  _dec_long(end, value, len);
+#else
+  for (; len; --len, value /= 10U) {
+    *--end = (char)('0' + value % 10U);
+  }
+#endif
+}
+
+
+// internal base 10 digits of 'value', 'len' digits are written backwards from 'end'
+// a 64-bit division is a library call on 32-bit targets, so values above 32 bits are split into chunks of
+// 9 digits by one 64-bit division each (at most two), all digits are converted with 32-bit divisions
+static void _dec_long_long(char* end, unsigned long long value, size_t len)
+{
+  while ((value >> 32U) && (len > 9U)) {
+    const uint32_t chunk = (uint32_t)(value % 1000000000U);
+    value /= 1000000000U;
+    _dec_uint32(end, chunk, 9U);
+    end -= 9U;
+    len -= 9U;
+  }
+  _dec_uint32(end, (uint32_t)((value >> 32U) ? value % 1000000000U : value), len);
+}
+
+
+// internal digit tables of the power of two bases
+static const char _digits[2][17] = { "0123456789abcdef", "0123456789ABCDEF" };
+
+
+#if defined(PRINTF_SUPPORT_SIMD)
+// internal hex digits of a 64-bit value, all 16 nibbles are converted at once,
+// the 'len' least significant digits are written backwards from 'end'
+static void _hex_simd(char* end, unsigned long long value, size_t len, bool uppercase)
+{
+  char hex[16];
+  const char letter = (char)((uppercase ? 'A' : 'a') - '0' - 10);
+  // byte swapped, so the most significant byte comes first
+  const unsigned long long swapped = __builtin_bswap64(value);
+#if defined(__SSE2__)
+  const __m128i v    = _mm_loadl_epi64((const __m128i*)(const void*)&swapped);
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  // interleave high and low nibbles, most significant nibble first
+  const __m128i nib  = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(v, 4), mask), _mm_and_si128(v, mask));
+  const __m128i adj  = _mm_and_si128(_mm_cmpgt_epi8(nib, _mm_set1_epi8(9)), _mm_set1_epi8(letter));
+  _mm_storeu_si128((__m128i*)(void*)hex, _mm_add_epi8(_mm_add_epi8(nib, _mm_set1_epi8('0')), adj));
+#else
+  const uint8x8_t   v   = vcreate_u8((uint64_t)swapped);
+  // interleave high and low nibbles, most significant nibble first
+  const uint8x8x2_t z   = vzip_u8(vshr_n_u8(v, 4), vand_u8(v, vdup_n_u8(0x0FU)));
+  const uint8x16_t  nib = vcombine_u8(z.val[0], z.val[1]);
+  const uint8x16_t  adj = vandq_u8(vcgtq_u8(nib, vdupq_n_u8(9U)), vdupq_n_u8((uint8_t)letter));
+  vst1q_u8((uint8_t*)hex, vaddq_u8(vaddq_u8(nib, vdupq_n_u8((uint8_t)'0')), adj));
+#endif
+  for (const char* src = hex + 16; len; --len) {
+    *--end = *--src;
+  }
+}
+#endif  // PRINTF_SUPPORT_SIMD
+
+
+// internal digits of 'value' in base 2, 8 or 16 ('shift' bits per digit) without division,
+// 'len' digits are written backwards from 'end'
+static void _pow2_long(char* end, unsigned long value, size_t len, unsigned int shift, bool uppercase)
+{
+#if defined(PRINTF_SUPPORT_SIMD)
+  if ((shift == 4U) && (len <= 16U) && (sizeof(unsigned long) == sizeof(unsigned long long))) {
+    _hex_simd(end, value, len, uppercase);
+    return;
   }
+#endif
+  const char* digits = _digits[uppercase ? 1 : 0];
+  const unsigned long mask = (1UL << shift) - 1U;
+  for (; len; --len) {
+    *--end = digits[value & mask];
+    value >>= shift;
+  }
+}
+
 
-  return _out_rev(out, buffer, idx, maxlen, buf, len, width, flags);
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+// internal digits of 'value' in base 2, 8 or 16 ('shift' bits per digit) without division,
+// 'len' digits are written backwards from 'end'
+static void _pow2_long_long(char* end, unsigned long long value, size_t len, unsigned int shift, bool uppercase)
+{
+#if defined(PRINTF_SUPPORT_SIMD)
+  if ((shift == 4U) && (len <= 16U)) {
+    _hex_simd(end, value, len, uppercase);
+    return;
+  }
+#endif
+  const char* digits = _digits[uppercase ? 1 : 0];
+  const unsigned long long mask = (1ULL << shift) - 1U;
+  for (; len; --len) {
+    *--end = digits[value & mask];
+    value >>= shift;
+  }
 }
+#endif  // PRINTF_SUPPORT_LONG_LONG
 
 
 // internal itoa for 'long' type
 static size_t _ntoa_long(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long value, bool negative, unsigned long base, unsigned int prec, unsigned int width, unsigned int flags)
 {
   char buf[PRINTF_NTOA_BUFFER_SIZE];
+  const size_t start = idx;
   size_t len = 0U;
 
   // no hash for 0 values
@@ -290,14 +809,34 @@ static size_t _ntoa_long(out_fct_type out, char* buffer, size_t idx, size_t maxl
 
   // write if precision != 0 and value is != 0
   if (!(flags & FLAGS_PRECISION) || value) {
-    do {
-      const char digit = (char)(value % base);
-      buf[len++] = digit < 10 ? '0' + digit : (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-      value /= base;
-    } while (value && (len < PRINTF_NTOA_BUFFER_SIZE));
+    len = _ntoa_count(value, (unsigned int)base);
+    len = len < PRINTF_NTOA_BUFFER_SIZE ? len : PRINTF_NTOA_BUFFER_SIZE;
+  }
+  idx = _ntoa_format(out, buffer, idx, maxlen, &len, negative, (unsigned int)base, prec, width, flags);
+
+  // digits in forward order, straight into the output buffer if possible
+  if (len) {
+    char* dest = _out_dest(out, buffer, idx, maxlen, len, buf);
+    if ((base == 16U) || (base == 8U) || (base == 2U)) {
+      _pow2_long(dest + len, value, len, base == 16U ? 4U : (base == 8U ? 3U : 1U), (flags & FLAGS_UPPERCASE) != 0U);
+    }
+#if defined(PRINTF_OPTIMIZE_FOR_SPEED)
+    else if (base == 10U) {
+      _dec_long(dest + len, value, len);
+    }
+#endif
+    else {
+      for (char* p = dest + len; p != dest; value /= base) {
+        *--p = (char)('0' + value % base);
+      }
+    }
+    if (dest == buf) {
+      out(buf, len, buffer, idx, maxlen);
+    }
+    idx += len;
   }
 
-  return _ntoa_format(out, buffer, idx, maxlen, buf, len, negative, (unsigned int)base, prec, width, flags);
+  return _out_number_tail(out, buffer, start, idx, maxlen, width, flags);
 }
 
 
@@ -306,6 +845,7 @@ static size_t _ntoa_long(out_fct_type out, char* buffer, size_t idx, size_t maxl
 static size_t _ntoa_long_long(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long long value, bool negative, unsigned long long base, unsigned int prec, unsigned int width, unsigned int flags)
 {
   char buf[PRINTF_NTOA_BUFFER_SIZE];
+  const size_t start = idx;
   size_t len = 0U;
 
   // no hash for 0 values
@@ -315,600 +855,3560 @@ static size_t _ntoa_long_long(out_fct_type out, char* buffer, size_t idx, size_t
 
   // write if precision != 0 and value is != 0
   if (!(flags & FLAGS_PRECISION) || value) {
-    do {
-      const char digit = (char)(value % base);
-      buf[len++] = digit < 10 ? '0' + digit : (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-      value /= base;
-    } while (value && (len < PRINTF_NTOA_BUFFER_SIZE));
+    len = _ntoa_count(value, (unsigned int)base);
+    len = len < PRINTF_NTOA_BUFFER_SIZE ? len : PRINTF_NTOA_BUFFER_SIZE;
+  }
+  idx = _ntoa_format(out, buffer, idx, maxlen, &len, negative, (unsigned int)base, prec, width, flags);
+
+  // digits in forward order, straight into the output buffer if possible
+  if (len) {
+    char* dest = _out_dest(out, buffer, idx, maxlen, len, buf);
+    if ((base == 16U) || (base == 8U) || (base == 2U)) {
+      _pow2_long_long(dest + len, value, len, base == 16U ? 4U : (base == 8U ? 3U : 1U), (flags & FLAGS_UPPERCASE) != 0U);
+    }
+    else {
+      _dec_long_long(dest + len, value, len);
+    }
+    if (dest == buf) {
+      out(buf, len, buffer, idx, maxlen);
+    }
+    idx += len;
   }
 
-  return _ntoa_format(out, buffer, idx, maxlen, buf, len, negative, (unsigned int)base, prec, width, flags);
+  return _out_number_tail(out, buffer, start, idx, maxlen, width, flags);
 }
 #endif  // PRINTF_SUPPORT_LONG_LONG
 
 
-#if defined(PRINTF_SUPPORT_FLOAT)
-
-#if defined(PRINTF_SUPPORT_EXPONENTIAL)
-// forward declaration so that _ftoa can switch to exp notation for values > PRINTF_MAX_FLOAT
-static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
-#endif
-
-
-// internal ftoa for fixed decimal floating point
-static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+// internal fixed point (Q format) conversion of 'value' / 2^bits, correctly rounded to 'prec' decimals (ties
+// to even) with integer math only. 'bits' is limited to 60, so the digit loop can't overflow.
+PRINTF_ENGINE_SHARED static size_t _qtoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long long value, bool negative, unsigned int bits, unsigned int prec, unsigned int width, unsigned int flags)
 {
-  char buf[PRINTF_FTOA_BUFFER_SIZE];
-  size_t len  = 0U;
-  double diff = 0.0;
-
-  // powers of 10
-  static const double pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
-
-  // test for special values
-  if (value != value)
-    return _out_rev(out, buffer, idx, maxlen, "nan", 3, width, flags);
-  if (value < -DBL_MAX)
-    return _out_rev(out, buffer, idx, maxlen, "fni-", 4, width, flags);
-  if (value > DBL_MAX)
-    return _out_rev(out, buffer, idx, maxlen, (flags & FLAGS_PLUS) ? "fni+" : "fni", (flags & FLAGS_PLUS) ? 4U : 3U, width, flags);
-
-  // test for very large values
-  // standard printf behavior is to print EVERY whole number digit -- which could be 100s of characters overflowing your buffers == bad
-  if ((value > PRINTF_MAX_FLOAT) || (value < -PRINTF_MAX_FLOAT)) {
-#if defined(PRINTF_SUPPORT_EXPONENTIAL)
-    return _etoa(out, buffer, idx, maxlen, value, prec, width, flags);
-#else
-    return 0U;
-#endif
-  }
-
-  // test for negative
-  bool negative = false;
-  if (value < 0) {
-    negative = true;
-    value = 0 - value;
-  }
+  char buf[20U + 1U + 60U];
+  const size_t start = idx;
 
   // set default precision, if not set explicitly
   if (!(flags & FLAGS_PRECISION)) {
     prec = PRINTF_DEFAULT_FLOAT_PRECISION;
   }
-  // limit precision to 9, cause a prec >= 10 can lead to overflow errors
-  while ((len < PRINTF_FTOA_BUFFER_SIZE) && (prec > 9U)) {
-    buf[len++] = '0';
-    prec--;
+  if (bits > 60U) {
+    bits = 60U;
   }
 
-  int whole = (int)value;
-  double tmp = (value - whole) * pow10[prec];
-  unsigned long frac = (unsigned long)tmp;
-  diff = tmp - frac;
-
-  if (diff > 0.5) {
-    ++frac;
-    // handle rollover, e.g. case 0.99 with prec 1 is 1.0
-    if (frac >= pow10[prec]) {
-      frac = 0;
-      ++whole;
+  // a fraction of 'bits' binary digits has exactly 'bits' decimals, the ones beyond are zeros
+  const unsigned long long mask = (1ULL << bits) - 1U;
+  unsigned long long whole = value >> bits;
+  unsigned long long frac  = value & mask;
+  const size_t n = prec < bits ? prec : bits;
+  char* digits = buf + 21U;
+  if (bits <= 28U) {
+    // the product fits in 32 bit
+    uint32_t f = (uint32_t)frac;
+    for (size_t i = 0U; i < n; ++i) {
+      f *= 10U;
+      digits[i] = (char)('0' + (f >> bits));
+      f &= (uint32_t)mask;
     }
+    frac = f;
   }
-  else if (diff < 0.5) {
-  }
-  else if ((frac == 0U) || (frac & 1U)) {
-    // if halfway, round up if odd OR if last digit is 0
-    ++frac;
-  }
-
-  if (prec == 0U) {
-    diff = value - (double)whole;
-    if ((!(diff < 0.5) || (diff > 0.5)) && (whole & 1)) {
-      // exactly 0.5 and ODD, then round up
-      // 1.5 -> 2, but 2.5 -> 2
-      ++whole;
+  else {
+    for (size_t i = 0U; i < n; ++i) {
+      frac *= 10U;
+      digits[i] = (char)('0' + (frac >> bits));
+      frac &= mask;
     }
   }
-  else {
-    unsigned int count = prec;
-    // now do fractional part, as an unsigned number
-    while (len < PRINTF_FTOA_BUFFER_SIZE) {
-      --count;
-      buf[len++] = (char)(48U + (frac % 10U));
-      if (!(frac /= 10U)) {
-        break;
+
+  // round the remainder half to even, the carry may ripple into the whole part
+  if (bits) {
+    const unsigned long long half = 1ULL << (bits - 1U);
+    const unsigned int last = n ? (unsigned int)(digits[n - 1U] - '0') : (unsigned int)whole;
+    if ((frac > half) || ((frac == half) && (last & 1U))) {
+      size_t i = n;
+      while (i && (digits[i - 1U] == '9')) {
+        digits[--i] = '0';
+      }
+      if (i) {
+        digits[i - 1U]++;
+      }
+      else {
+        whole++;
       }
-    }
-    // add extra 0s
-    while ((len < PRINTF_FTOA_BUFFER_SIZE) && (count-- > 0U)) {
-      buf[len++] = '0';
-    }
-    if (len < PRINTF_FTOA_BUFFER_SIZE) {
-      // add decimal
-      buf[len++] = '.';
     }
   }
 
-  // do whole part, number is reversed
-  while (len < PRINTF_FTOA_BUFFER_SIZE) {
-    buf[len++] = (char)(48 + (whole % 10));
-    if (!(whole /= 10)) {
-      break;
-    }
+  const size_t whole_len = _ntoa_count(whole, 10U);
+  size_t len = whole_len + (prec ? prec + 1U : 0U);
+  idx = _ntoa_format(out, buffer, idx, maxlen, &len, negative, 10U, 0U, width, flags & ~FLAGS_HASH);
+
+  // whole part and point in front of the fraction digits
+  char* p = digits - (prec ? 1U : 0U);
+  if (prec) {
+    *p = '.';
   }
+  _dec_long_long(p, whole, whole_len);
+  p -= whole_len;
+  out(p, (size_t)(digits + n - p), buffer, idx, maxlen);
+  idx += (size_t)(digits + n - p);
+  idx = _out_zeros(out, buffer, idx, maxlen, prec - n);
 
-  // pad leading zeros
+  return _out_number_tail(out, buffer, start, idx, maxlen, width, flags);
+}
+
+
+#if defined(PRINTF_SUPPORT_FLOAT)
+
+// internal limb counts of the exact fixed notation
+#define FTOA_WHOLE_LIMBS  35U   // base 1e9 limbs of the integer part of DBL_MAX (309 digits)
+#define FTOA_FRAC_LIMBS   34U   // 32-bit limbs of the fraction of the smallest subnormal (2^-1074)
+
+// internal fraction of a double, expanded 9 decimal digits at a time by _ftoa_frac_next()
+typedef struct {
+  uint32_t limb[FTOA_FRAC_LIMBS];   // little endian, the binary point is above the top limb
+  size_t   lo;                      // the limbs below are zero
+  size_t   n;
+} ftoa_frac_type;
+
+// internal exact fixed notation of a double, the integer part and the rounding of the fraction
+typedef struct {
+  uint64_t mant;                    // value = mant * 2^exp2
+  int      exp2;
+  uint64_t whole;                   // integer part, if it fits
+  uint32_t big[FTOA_WHOLE_LIMBS];   // integer part in base 1e9 limbs (little endian) otherwise
+  size_t   big_len;                 // number of limbs in 'big', 0 if 'whole' holds the integer part
+  size_t   whole_len;               // digits of the integer part
+  size_t   round_group;             // 9 digit group of the fraction taking the rounding increment, see FTOA_ROUND_*
+  uint64_t frac;                    // rounded fraction digits, if 'frac_ready'
+  bool     frac_ready;              // the fraction digits are computed up front in 'frac'
+} ftoa_fixed_type;
+
+#define FTOA_ROUND_NONE   ((size_t)-1)    // the fraction digits are not rounded up
+#define FTOA_ROUND_WHOLE  ((size_t)-2)    // the rounding carried into the integer part, the fraction is all zeros
+
+
+// internal setup of the fraction bits of mant * 2^-k
+static void _ftoa_frac_init(ftoa_frac_type* frac, uint64_t mant, unsigned int k)
+{
+  const uint64_t bits = k < 64U ? mant & ((1ULL << k) - 1U) : mant;
+  // scaled to a whole number of limbs, the 53 bits span at most three of them
+  const unsigned int shift = (k + 31U) / 32U * 32U - k;
+  const uint64_t     lo    = bits << shift;
+  const uint64_t     hi    = shift ? bits >> (64U - shift) : 0U;
+
+  frac->n  = (k + 31U) / 32U;
+  frac->lo = 0U;
+  for (size_t i = 0U; i < frac->n; ++i) {
+    frac->limb[i] = (i == 0U) ? (uint32_t)lo : (i == 1U) ? (uint32_t)(lo >> 32U) : (i == 2U) ? (uint32_t)hi : 0U;
+  }
+  while ((frac->lo < frac->n) && !frac->limb[frac->lo]) {
+    ++frac->lo;
+  }
+}
+
+
+// internal next 9 decimal digits of the fraction, as a number below 1e9
+static uint32_t _ftoa_frac_next(ftoa_frac_type* frac)
+{
+  uint64_t carry = 0U;
+  for (size_t i = frac->lo; i < frac->n; ++i) {
+    const uint64_t t = (uint64_t)frac->limb[i] * 1000000000U + carry;
+    frac->limb[i] = (uint32_t)t;
+    carry = t >> 32U;
+  }
+  // multiplying by 1e9 shifts in 9 zero bits at the bottom
+  while ((frac->lo < frac->n) && !frac->limb[frac->lo]) {
+    ++frac->lo;
+  }
+  return (uint32_t)carry;
+}
+
+
+// internal fields of a finite double, value = mant * 2^exp2
+static inline uint64_t _ftoa_decode(uint64_t bits, int* exp2)
+{
+  const int biased = (int)((bits >> 52U) & 0x7FFU);
+  *exp2 = biased ? biased - 1075 : -1074;
+  return (bits & ((1ULL << 52U) - 1U)) | (biased ? 1ULL << 52U : 0U);
+}
+
+
+// internal integer mant * 2^exp2 in base 1e9 limbs (little endian), multiplied up 29 bits at a time
+// \return The number of limbs
+static size_t _ftoa_big(uint32_t* big, uint64_t mant, int exp2)
+{
+  big[0] = (uint32_t)(mant % 1000000000U);
+  big[1] = (uint32_t)(mant / 1000000000U % 1000000000U);
+  big[2] = (uint32_t)(mant / 1000000000U / 1000000000U);
+  size_t len = big[2] ? 3U : big[1] ? 2U : 1U;
+  for (int e = exp2; e > 0; e -= 29) {
+    const unsigned int shift = e < 29 ? (unsigned int)e : 29U;
+    uint64_t carry = 0U;
+    for (size_t i = 0U; i < len; ++i) {
+      const uint64_t t = ((uint64_t)big[i] << shift) + carry;
+      big[i] = (uint32_t)(t % 1000000000U);
+      carry  = t / 1000000000U;
+    }
+    if (carry) {
+      big[len++] = (uint32_t)carry;
+    }
+  }
+  return len;
+}
+
+
+// internal exact fixed notation of a finite, non-negative value mant * 2^exp2 at 'prec' fraction digits
+// computes the integer part and where the fraction is rounded (half to even), the fraction digits
+// themselves are generated again by the output
+static void _ftoa_fixed(ftoa_fixed_type* fx, uint64_t mant, int exp2, unsigned int prec)
+{
+  // trailing zero bits of the mantissa are moved into the exponent
+  if (!mant) {
+    exp2 = 0;
+  }
+#if defined(__GNUC__)
+  if ((exp2 < 0) && mant) {
+    const int tz = __builtin_ctzll(mant);
+    const int n  = tz < -exp2 ? tz : -exp2;
+    mant >>= n;
+    exp2  += n;
+  }
+#else
+  while ((exp2 < 0) && !(mant & 1U)) {
+    mant >>= 1U;
+    ++exp2;
+  }
+#endif
+  fx->mant        = mant;
+  fx->exp2        = exp2;
+  fx->big_len     = 0U;
+  fx->round_group = FTOA_ROUND_NONE;
+  fx->frac        = 0U;
+  fx->frac_ready  = false;
+
+  if (exp2 >= 0) {
+    // an integer, no fraction to round
+    if ((exp2 < 64) && (((mant << exp2) >> exp2) == mant)) {
+      fx->whole     = mant << exp2;
+      fx->whole_len = _ntoa_count(fx->whole, 10U);
+      return;
+    }
+    // too large for 64 bits
+    fx->big_len   = _ftoa_big(fx->big, mant, exp2);
+    fx->whole_len = _ntoa_count(fx->big[fx->big_len - 1U], 10U) + (fx->big_len - 1U) * 9U;
+    return;
+  }
+
+  const unsigned int k = (unsigned int)-exp2;
+  fx->whole = k < 64U ? mant >> k : 0U;
+
+  // up to 32 significant bits (e.g. all floats) and 9 fraction digits: one 32x32 bit multiplication
+  // gives the digits and the remainder to round with, beyond 2^-63 the digits are all zero
+  if (!(mant >> 32U) && (prec < 10U)) {
+    const uint64_t scaled = (uint64_t)(uint32_t)(k < 32U ? mant & ((1U << k) - 1U) : mant) * (uint32_t)_pow10_ull[prec];
+    fx->frac       = k < 64U ? scaled >> k : 0U;
+    fx->frac_ready = true;
+    if (k < 64U) {
+      const uint64_t rem  = scaled & ((1ULL << k) - 1U);
+      const uint64_t half = 1ULL << (k - 1U);
+      if ((rem > half) || ((rem == half) && ((prec ? fx->frac : fx->whole) & 1U))) {
+        if (++fx->frac == _pow10_ull[prec]) {
+          fx->frac = 0U;
+          ++fx->whole;
+        }
+      }
+    }
+    fx->whole_len = _ntoa_count(fx->whole, 10U);
+    return;
+  }
+
+#if defined(__SIZEOF_INT128__)
+  // common case: up to 19 fraction digits of a value above 2^-75, one 128-bit multiplication
+  // of the 53 bit fraction gives the digits and the remainder to round with
+  if ((k < 128U) && (prec < 20U)) {
+    __extension__ typedef unsigned __int128 uint128_type;
+    const uint128_type scaled = (uint128_type)(k < 64U ? mant & ((1ULL << k) - 1U) : mant) * _pow10_ull[prec];
+    const uint128_type rem    = scaled & (((uint128_type)1U << k) - 1U);
+    const uint128_type half   = (uint128_type)1U << (k - 1U);
+    fx->frac       = (uint64_t)(scaled >> k);
+    fx->frac_ready = true;
+    if ((rem > half) || ((rem == half) && ((prec ? fx->frac : fx->whole) & 1U))) {
+      // round half to even, with the carry into the integer part, e.g. 0.99 with prec 1 is 1.0
+      if (++fx->frac == _pow10_ull[prec]) {
+        fx->frac = 0U;
+        ++fx->whole;
+      }
+    }
+    fx->whole_len = _ntoa_count(fx->whole, 10U);
+    return;
+  }
+#endif
+
+  // find the rounding of the fraction: the digits behind 'prec' against one half, and the last group
+  // which isn't all nines to take the increment
+  ftoa_frac_type frac;
+  _ftoa_frac_init(&frac, mant, k);
+  const size_t       groups = prec / 9U;
+  const unsigned int rest   = prec % 9U;
+  size_t   last = FTOA_ROUND_WHOLE;
+  uint32_t group = 0U, prev = 0U;
+  bool     up = false;
+  for (size_t g = 0U; frac.lo < frac.n; ++g) {
+    prev  = group;
+    group = _ftoa_frac_next(&frac);
+    if (g < groups) {
+      if (group != 999999999U) {
+        last = g;
+      }
+      continue;
+    }
+    // the group with the last 'rest' digits, followed by the rounding digits
+    const uint32_t scale = (uint32_t)_pow10_ull[9U - rest];
+    const uint32_t kept  = group / scale;
+    const uint32_t tail  = group % scale;
+    if (rest && (kept != (uint32_t)_pow10_ull[rest] - 1U)) {
+      last = g;
+    }
+    if (tail != scale / 2U) {
+      up = tail > scale / 2U;
+    }
+    else if (frac.lo < frac.n) {
+      up = true;
+    }
+    else {
+      // exactly halfway, round to even
+      up = ((rest ? kept : groups ? prev : (uint32_t)fx->whole) & 1U) != 0U;
+    }
+    break;
+  }
+
+  if (up) {
+    fx->round_group = last;
+    if (last == FTOA_ROUND_WHOLE) {
+      ++fx->whole;
+    }
+  }
+  fx->whole_len = _ntoa_count(fx->whole, 10U);
+}
+
+
+// output the specified string, taking care of any space padding
+static size_t _out_padded(out_fct_type out, char* buffer, size_t idx, size_t maxlen, const char* buf, size_t len, unsigned int width, unsigned int flags)
+{
+  // pad spaces up to given width
+  if (!(flags & FLAGS_LEFT) && !(flags & FLAGS_ZEROPAD) && (len < width)) {
+    idx = _out_spaces(out, buffer, idx, maxlen, width - len);
+  }
+
+  out(buf, len, buffer, idx, maxlen);
+  idx += len;
+
+  // append pad spaces up to given width
+  if ((flags & FLAGS_LEFT) && (len < width)) {
+    idx = _out_spaces(out, buffer, idx, maxlen, width - len);
+  }
+
+  return idx;
+}
+
+
+// internal ftoa of NaN and infinity
+static size_t _ftoa_special(out_fct_type out, char* buffer, size_t idx, size_t maxlen, bool nan, bool negative, unsigned int width, unsigned int flags)
+{
+  if (nan)
+    return _out_padded(out, buffer, idx, maxlen, "nan", 3, width, flags);
+  if (negative)
+    return _out_padded(out, buffer, idx, maxlen, "-inf", 4, width, flags);
+  return _out_padded(out, buffer, idx, maxlen, (flags & FLAGS_PLUS) ? "+inf" : "inf", (flags & FLAGS_PLUS) ? 4U : 3U, width, flags);
+}
+
+
+// internal ftoa for fixed decimal floating point of the finite value mant * 2^exp2, exact for all
+// values and precisions, only integer math is used
+static size_t _ftoa_exact(out_fct_type out, char* buffer, size_t idx, size_t maxlen, bool negative, uint64_t mant, int exp2, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  char buf[PRINTF_FTOA_BUFFER_SIZE];
+  const size_t start = idx;
+
+  // set default precision, if not set explicitly
+  if (!(flags & FLAGS_PRECISION)) {
+    prec = PRINTF_DEFAULT_FLOAT_PRECISION;
+  }
+
+  ftoa_fixed_type fx;
+  _ftoa_fixed(&fx, mant, exp2, prec);
+  const size_t len = fx.whole_len + (prec ? prec + 1U : 0U);
+
+  // pad leading zeros
+  size_t zeros = 0U;
   if (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
     if (width && (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE)))) {
       width--;
     }
-    while ((len < width) && (len < PRINTF_FTOA_BUFFER_SIZE)) {
-      buf[len++] = '0';
+    if (len < width) {
+      zeros = width - len;
     }
   }
 
-  if (len < PRINTF_FTOA_BUFFER_SIZE) {
-    if (negative) {
-      buf[len++] = '-';
+  const char* sign = negative ? "-" : (flags & FLAGS_PLUS) ? "+" : (flags & FLAGS_SPACE) ? " " : "";
+  idx = _out_number_head(out, buffer, idx, maxlen, sign, *sign ? 1U : 0U, zeros, len, width, flags);
+
+  // whole part in forward order, its digits are counted up front
+  if (!fx.big_len) {
+    _dec_long_long(buf + fx.whole_len, fx.whole, fx.whole_len);
+    out(buf, fx.whole_len, buffer, idx, maxlen);
+    idx += fx.whole_len;
+  }
+  else {
+    // most significant limb first, the others with leading zeros
+    for (size_t i = fx.big_len; i--; ) {
+      const size_t n = (i == fx.big_len - 1U) ? fx.whole_len - i * 9U : 9U;
+      _dec_long_long(buf + n, fx.big[i], n);
+      out(buf, n, buffer, idx, maxlen);
+      idx += n;
     }
-    else if (flags & FLAGS_PLUS) {
-      buf[len++] = '+';  // ignore the space if the '+' exists
+  }
+
+  if (prec && fx.frac_ready) {
+    // decimal point and fractional part, with leading zeros up to the precision
+    buf[0] = '.';
+    _dec_long_long(buf + 1U + prec, fx.frac, prec);
+    out(buf, prec + 1U, buffer, idx, maxlen);
+    idx += prec + 1U;
+  }
+  else if (prec) {
+    // decimal point and fractional part in groups of 9 digits, the digits behind the exact
+    // expansion of the binary fraction are zeros
+    ftoa_frac_type frac;
+    _ftoa_frac_init(&frac, fx.mant, fx.exp2 < 0 ? (unsigned int)-fx.exp2 : 0U);
+    out(".", 1U, buffer, idx++, maxlen);
+    for (size_t g = 0U, left = prec; left; ++g) {
+      const size_t n = left < 9U ? left : 9U;
+      if ((frac.lo == frac.n) || (fx.round_group == FTOA_ROUND_WHOLE) || ((fx.round_group != FTOA_ROUND_NONE) && (g > fx.round_group))) {
+        idx  = _out_zeros(out, buffer, idx, maxlen, left);
+        break;
+      }
+      uint32_t group = _ftoa_frac_next(&frac) / (uint32_t)_pow10_ull[9U - n];
+      if (g == fx.round_group) {
+        ++group;
+      }
+      _dec_long_long(buf + n, group, n);
+      out(buf, n, buffer, idx, maxlen);
+      idx  += n;
+      left -= n;
     }
-    else if (flags & FLAGS_SPACE) {
-      buf[len++] = ' ';
+  }
+
+  return _out_number_tail(out, buffer, start, idx, maxlen, width, flags);
+}
+
+
+// internal ftoa length, the number of characters _ftoa_exact() outputs without generating the fraction digits
+static size_t _ftoa_exact_len(bool negative, uint64_t mant, int exp2, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  if (!(flags & FLAGS_PRECISION)) {
+    prec = PRINTF_DEFAULT_FLOAT_PRECISION;
+  }
+
+  ftoa_fixed_type fx;
+  _ftoa_fixed(&fx, mant, exp2, prec);
+  const size_t sign = (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE))) ? 1U : 0U;
+  const size_t len  = fx.whole_len + (prec ? prec + 1U : 0U);
+
+  // leading zeros
+  size_t zeros = 0U;
+  if (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
+    const size_t w = (width && sign) ? width - 1U : width;
+    if (len < w) {
+      zeros = w - len;
     }
   }
+  return _number_len(sign + zeros + len, width, flags);
+}
+
+
+// internal ftoa for fixed decimal floating point of a double, it is converted on its IEEE-754 bits
+// -0.0 and values rounding to zero keep the sign of the value, -0.0 is printed without
+PRINTF_ENGINE_SHARED static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  union {
+    uint64_t U;
+    double   F;
+  } conv;
+  conv.F = value;
+
+  int exp2;
+  const uint64_t mant     = _ftoa_decode(conv.U, &exp2);
+  const bool     negative = (conv.U >> 63U) && (conv.U << 1U);
+  if (exp2 == 2047 - 1075) {
+    return _ftoa_special(out, buffer, idx, maxlen, (conv.U << 12U) != 0U, negative, width, flags);
+  }
+  return _ftoa_exact(out, buffer, idx, maxlen, negative, mant, exp2, prec, width, flags);
+}
+
+
+// internal ftoa length of a double
+static size_t _ftoa_len(double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  union {
+    uint64_t U;
+    double   F;
+  } conv;
+  conv.F = value;
+
+  int exp2;
+  const uint64_t mant     = _ftoa_decode(conv.U, &exp2);
+  const bool     negative = (conv.U >> 63U) && (conv.U << 1U);
+  if (exp2 == 2047 - 1075) {
+    // special values are rare, they are measured by a conversion
+    return _ftoa_special(_out_null, NULL, 0U, 0U, (conv.U << 12U) != 0U, negative, width, flags);
+  }
+  return _ftoa_exact_len(negative, mant, exp2, prec, width, flags);
+}
+
+
+#if defined(PRINTF_SUPPORT_FLOAT32) || defined(PRINTF_SUPPORT_ROUNDTRIP)
+// internal rounding of a double to float (half to even) on the IEEE-754 bits, like a (float) cast
+static uint32_t _ftoa_float_bits(double value)
+{
+  union {
+    uint64_t U;
+    double   F;
+  } conv;
+  conv.F = value;
+
+  const uint32_t sign   = (uint32_t)(conv.U >> 32U) & 0x80000000U;
+  const int      biased = (int)((conv.U >> 52U) & 0x7FFU);
+  if (biased == 0x7FF) {
+    // infinity or a quiet NaN
+    return sign | 0x7F800000U | ((conv.U << 12U) ? 0x400000U : 0U);
+  }
+  // float biased exponent, double subnormals and values below half the smallest float subnormal are zero
+  const int exp = biased - 1023 + 127;
+  if (!biased || (exp < -24)) {
+    return sign;
+  }
+  if (exp >= 0xFF) {
+    return sign | 0x7F800000U;
+  }
+
+  // drop the 29 extra mantissa bits, more for subnormal floats
+  const uint64_t     mant  = (conv.U & ((1ULL << 52U) - 1U)) | (1ULL << 52U);
+  const unsigned int shift = exp > 0 ? 29U : 30U - (unsigned int)exp;
+  const uint64_t     rem   = mant & ((1ULL << shift) - 1U);
+  const uint64_t     half  = 1ULL << (shift - 1U);
+  uint32_t kept = (uint32_t)(mant >> shift);
+  if ((rem > half) || ((rem == half) && (kept & 1U))) {
+    ++kept;
+  }
+  // the hidden bit adds one to the exponent, a carry of the rounding up to infinity too
+  return sign | ((exp > 0 ? (uint32_t)(exp - 1) << 23U : 0U) + kept);
+}
+#endif
+
+
+#if defined(PRINTF_SUPPORT_FLOAT32)
+// internal ftoa for fixed decimal floating point of a float, given by its IEEE-754 bits
+PRINTF_ENGINE_SHARED static size_t _ftoa32(out_fct_type out, char* buffer, size_t idx, size_t maxlen, uint32_t bits, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  const int      biased   = (int)((bits >> 23U) & 0xFFU);
+  const uint32_t mant     = (bits & ((1U << 23U) - 1U)) | (biased ? 1U << 23U : 0U);
+  const bool     negative = (bits >> 31U) && (bits << 1U);
+  if (biased == 0xFF) {
+    return _ftoa_special(out, buffer, idx, maxlen, (bits << 9U) != 0U, negative, width, flags);
+  }
+  return _ftoa_exact(out, buffer, idx, maxlen, negative, mant, biased ? biased - 150 : -149, prec, width, flags);
+}
+
 
-  return _out_rev(out, buffer, idx, maxlen, buf, len, width, flags);
+// internal ftoa length of a float
+static size_t _ftoa32_len(uint32_t bits, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  const int      biased   = (int)((bits >> 23U) & 0xFFU);
+  const uint32_t mant     = (bits & ((1U << 23U) - 1U)) | (biased ? 1U << 23U : 0U);
+  const bool     negative = (bits >> 31U) && (bits << 1U);
+  if (biased == 0xFF) {
+    return _ftoa_special(_out_null, NULL, 0U, 0U, (bits << 9U) != 0U, negative, width, flags);
+  }
+  return _ftoa_exact_len(negative, mant, biased ? biased - 150 : -149, prec, width, flags);
 }
+#endif  // PRINTF_SUPPORT_FLOAT32
 
 
 #if defined(PRINTF_SUPPORT_EXPONENTIAL)
-// internal ftoa variant for exponential floating-point type, contributed by Martijn Jasperse <m.jasperse@gmail.com>
-static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+// internal significant decimal digits of a value, in groups of up to 9: the integer part in base 1e9
+// limbs, followed by the fraction
+typedef struct {
+  uint32_t       big[FTOA_WHOLE_LIMBS];   // integer part, little endian, the top limbs are already returned
+  size_t         big_len;
+  ftoa_frac_type frac;
+  uint32_t       first;                   // first group, without leading zeros
+  size_t         first_len;               // its digits, 0 once returned
+} etoa_digits_type;
+
+
+// internal setup of the digits of the finite, non zero value mant * 2^exp2
+// \return The decimal exponent of the first digit
+static int _etoa_digits_init(etoa_digits_type* d, uint64_t mant, int exp2)
 {
-  // check for NaN and special values
-  if ((value != value) || (value > DBL_MAX) || (value < -DBL_MAX)) {
-    return _ftoa(out, buffer, idx, maxlen, value, prec, width, flags);
+  if (exp2 >= 0) {
+    d->big_len = _ftoa_big(d->big, mant, exp2);
+    d->frac.lo = d->frac.n = 0U;
+  }
+  else {
+    const unsigned int k     = (unsigned int)-exp2;
+    const uint64_t     whole = k < 64U ? mant >> k : 0U;
+    d->big_len = whole ? _ftoa_big(d->big, whole, 0) : 0U;
+    _ftoa_frac_init(&d->frac, mant, k);
   }
 
-  // determine the sign
-  const bool negative = value < 0;
-  if (negative) {
-    value = -value;
+  if (d->big_len) {
+    d->first     = d->big[--d->big_len];
+    d->first_len = _ntoa_count(d->first, 10U);
+    return (int)(d->first_len + d->big_len * 9U) - 1;
+  }
+  // below one, the leading zero groups of the fraction are skipped
+  int exp10 = -1;
+  while (!(d->first = _ftoa_frac_next(&d->frac))) {
+    exp10 -= 9;
   }
+  d->first_len = _ntoa_count(d->first, 10U);
+  return exp10 - (int)(9U - d->first_len);
+}
 
-  // default precision
-  if (!(flags & FLAGS_PRECISION)) {
-    prec = PRINTF_DEFAULT_FLOAT_PRECISION;
+
+// internal next group of digits, 'n' receives its number of digits
+static uint32_t _etoa_digits_next(etoa_digits_type* d, size_t* n)
+{
+  if (d->first_len) {
+    *n = d->first_len;
+    d->first_len = 0U;
+    return d->first;
+  }
+  *n = 9U;
+  if (d->big_len) {
+    return d->big[--d->big_len];
+  }
+  return (d->frac.lo < d->frac.n) ? _ftoa_frac_next(&d->frac) : 0U;
+}
+
+
+// internal test for non zero digits behind the returned groups
+static bool _etoa_digits_more(const etoa_digits_type* d)
+{
+  for (size_t i = 0U; i < d->big_len; ++i) {
+    if (d->big[i]) {
+      return true;
+    }
+  }
+  return d->frac.lo < d->frac.n;
+}
+
+
+// internal exponential notation of the finite value mant * 2^exp2 with 'prec' fraction digits, exactly
+// rounded (half to even) with integer math only, also used by the double based conversion for the digits
+// beyond double precision
+static size_t _etoa_exact(out_fct_type out, char* buffer, size_t idx, size_t maxlen, bool negative, uint64_t mant, int exp2, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  char buf[PRINTF_FTOA_BUFFER_SIZE];
+  const size_t start = idx;
+
+  // find the rounding: the digits behind 'prec' + 1 significant digits against one half, and the
+  // last group which isn't all nines to take the increment
+  etoa_digits_type d;
+  int    exp10 = mant ? _etoa_digits_init(&d, mant, exp2) : 0;
+  size_t last  = FTOA_ROUND_WHOLE;
+  bool   up    = false;
+  if (mant) {
+    uint32_t prev = 0U;
+    size_t   left = prec + 1U;
+    for (size_t g = 0U; ; ++g) {
+      size_t n;
+      const uint32_t group = _etoa_digits_next(&d, &n);
+      if (n <= left) {
+        if (group != (uint32_t)_pow10_ull[n] - 1U) {
+          last = g;
+        }
+        left -= n;
+        prev  = group;
+        if (!left && !_etoa_digits_more(&d)) {
+          break;
+        }
+        continue;
+      }
+      // the group with the last 'left' digits, followed by the rounding digits
+      const uint32_t scale = (uint32_t)_pow10_ull[n - left];
+      const uint32_t kept  = group / scale;
+      const uint32_t tail  = group % scale;
+      if (left && (kept != (uint32_t)_pow10_ull[left] - 1U)) {
+        last = g;
+      }
+      if (tail != scale / 2U) {
+        up = tail > scale / 2U;
+      }
+      else if (_etoa_digits_more(&d)) {
+        up = true;
+      }
+      else {
+        // exactly halfway, round to even
+        up = ((left ? kept : prev) & 1U) != 0U;
+      }
+      break;
+    }
+  }
+  // all nines rounded up to the next power of ten
+  const bool carry = up && (last == FTOA_ROUND_WHOLE);
+  if (carry) {
+    ++exp10;
+  }
+
+  // "d.ddde+XX", at least two exponent digits
+  const unsigned int e   = (unsigned int)(exp10 < 0 ? -exp10 : exp10);
+  const size_t       len = 1U + (prec ? prec + 1U : 0U) + (e >= 100U ? 5U : 4U);
+
+  // pad leading zeros
+  size_t zeros = 0U;
+  if (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
+    if (width && (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE)))) {
+      width--;
+    }
+    if (len < width) {
+      zeros = width - len;
+    }
+  }
+
+  const char* sign = negative ? "-" : (flags & FLAGS_PLUS) ? "+" : (flags & FLAGS_SPACE) ? " " : "";
+  idx = _out_number_head(out, buffer, idx, maxlen, sign, *sign ? 1U : 0U, zeros, len, width, flags);
+
+  if (!mant || carry) {
+    out(carry ? "1" : "0", 1U, buffer, idx++, maxlen);
+    if (prec) {
+      out(".", 1U, buffer, idx++, maxlen);
+      idx = _out_zeros(out, buffer, idx, maxlen, prec);
+    }
   }
+  else {
+    // the digits again, with the point behind the first one
+    (void)_etoa_digits_init(&d, mant, exp2);
+    size_t left = prec + 1U;
+    for (size_t g = 0U; left; ++g) {
+      if (up && (g > last)) {
+        idx = _out_zeros(out, buffer, idx, maxlen, left);
+        break;
+      }
+      size_t n;
+      uint32_t group = _etoa_digits_next(&d, &n);
+      if (n > left) {
+        group /= (uint32_t)_pow10_ull[n - left];
+        n      = left;
+      }
+      if (up && (g == last)) {
+        ++group;
+      }
+      _dec_long_long(buf + n, group, n);
+      if (!g) {
+        out(buf, 1U, buffer, idx++, maxlen);
+        if (prec) {
+          out(".", 1U, buffer, idx++, maxlen);
+        }
+        out(buf + 1U, n - 1U, buffer, idx, maxlen);
+        idx += n - 1U;
+      }
+      else {
+        out(buf, n, buffer, idx, maxlen);
+        idx += n;
+      }
+      left -= n;
+    }
+  }
+
+  // exponent
+  size_t elen = 0U;
+  buf[elen++] = (flags & FLAGS_UPPERCASE) ? 'E' : 'e';
+  buf[elen++] = exp10 < 0 ? '-' : '+';
+  if (e >= 100U) {
+    buf[elen++] = (char)('0' + e / 100U);
+  }
+  buf[elen++] = (char)('0' + e / 10U % 10U);
+  buf[elen++] = (char)('0' + e % 10U);
+  out(buf, elen, buffer, idx, maxlen);
+
+  return _out_number_tail(out, buffer, start, idx + elen, maxlen, width, flags);
+}
+
 
-  // determine the decimal exponent
-  // based on the algorithm by David Gay (https://www.ampl.com/netlib/fp/dtoa.c)
+#if defined(PRINTF_FLOAT_INTEGER_ONLY)
+// internal exponential floating point (%e and %g) with integer math only, the %g selection of the
+// fixed notation by the value and its precision handling are the same as the double based conversion
+PRINTF_ENGINE_SHARED static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
   union {
     uint64_t U;
     double   F;
   } conv;
-
   conv.F = value;
-  int exp2 = (int)((conv.U >> 52U) & 0x07FFU) - 1023;           // effectively log2
-  conv.U = (conv.U & ((1ULL << 52U) - 1U)) | (1023ULL << 52U);  // drop the exponent so conv.F is now in [1,2)
-  // now approximate log10 from the log2 integer part and an expansion of ln around 1.5
-  int expval = (int)(0.1760912590558 + exp2 * 0.301029995663981 + (conv.F - 1.5) * 0.289529654602168);
-  // now we want to compute 10^expval but we want to be sure it won't overflow
-  exp2 = (int)(expval * 3.321928094887362 + 0.5);
-  const double z  = expval * 2.302585092994046 - exp2 * 0.6931471805599453;
-  const double z2 = z * z;
-  conv.U = (uint64_t)(exp2 + 1023) << 52U;
-  // compute exp(z) using continued fractions, see https://en.wikipedia.org/wiki/Exponential_function#Continued_fractions_for_ex
-  conv.F *= 1 + 2 * z / (2 - z + (z2 / (6 + (z2 / (10 + z2 / 14)))));
-  // correct for rounding errors
-  if (value < conv.F) {
-    expval--;
-    conv.F /= 10;
-  }
-
-  // the exponent format is "%+03d" and largest value is "307", so set aside 4-5 characters
-  unsigned int minwidth = ((expval < 100) && (expval > -100)) ? 4U : 5U;
 
-  // in "%g" mode, "prec" is the number of *significant figures* not decimals
+  int exp2;
+  const uint64_t mant     = _ftoa_decode(conv.U, &exp2);
+  const bool     negative = (conv.U >> 63U) && (conv.U << 1U);
+  if (exp2 == 2047 - 1075) {
+    return _ftoa_special(out, buffer, idx, maxlen, (conv.U << 12U) != 0U, negative, width, flags);
+  }
+
+  // default precision
+  if (!(flags & FLAGS_PRECISION)) {
+    prec = PRINTF_DEFAULT_FLOAT_PRECISION;
+  }
+
   if (flags & FLAGS_ADAPT_EXP) {
-    // do we want to fall-back to "%f" mode?
-    if ((value >= 1e-4) && (value < 1e6)) {
-      if ((int)prec > expval) {
-        prec = (unsigned)((int)prec - expval - 1);
+    // "%g" mode, the fixed notation for values in [1e-4, 1e6)
+    if (mant) {
+      etoa_digits_type d;
+      const int expval = _etoa_digits_init(&d, mant, exp2);
+      if ((expval >= -4) && (expval < 6)) {
+        prec = ((int)prec > expval) ? (unsigned)((int)prec - expval - 1) : 0U;
+        return _ftoa_exact(out, buffer, idx, maxlen, negative, mant, exp2, prec, width, (flags | FLAGS_PRECISION) & ~FLAGS_ADAPT_EXP);
       }
-      else {
-        prec = 0;
+    }
+    // we use one sigfig for the whole part
+    if ((prec > 0) && (flags & FLAGS_PRECISION)) {
+      --prec;
+    }
+  }
+  return _etoa_exact(out, buffer, idx, maxlen, negative, mant, exp2, prec, width, flags);
+}
+
+#else
+
+// internal powers of ten 10^-(16 * i - 320) for scaling a value to [1,10), normalized to [1,2): the low 52 bits are
+// the IEEE-754 fraction, the top 12 bits the binary exponent + 2048
+static const uint64_t _etoa_pow10[41] = {
+  0xc2703085e53e599cU, 0xbf1d2a1be4048f90U, 0xbbca44df832b8d46U, 0xb877a93a2954f3b8U,
+  0xb5254fdd7f73bf3cU, 0xb1d33234de7ad7e3U, 0xae814a52dffc6799U, 0xab2f25c186a6f04cU,
+  0xa7dc0e1ef1a724ebU, 0xa48945145230b378U, 0xa136c2d4256ffcc3U, 0x9de4805738b51a75U,
+  0x9a927748f9301d32U, 0x9740a1f5b8132466U, 0x93edf67562d8b363U, 0x909afcef51f0fb5fU,
+  0x8d484f03e93ff9f5U, 0x89f5e531a0a1c873U, 0x86a3b8b5b5056e17U, 0x8351c37937e08000U,
+  0x8000000000000000U, 0x7cacd2b297d889bcU, 0x7959f623d5a8a733U, 0x7607624f8a762fd8U,
+  0x72b50ffd44f4a73dU, 0x6f62f8ac174d6123U, 0x6c1116805effaeaaU, 0x68bec866b79e0cbaU,
+  0x656bba08cf8c979dU, 0x6218f9574dcf8a70U, 0x5ec67e9c127b6e74U, 0x5b7442e4fb671960U,
+  0x58223ff06eea847aU, 0x54d0701bd527b498U, 0x517d9ca79d89462aU, 0x4e2aac0bf9b9e65cU,
+  0x4ad8062864ac6f43U, 0x4785a391d56bdc87U, 0x44337d99cc506d59U, 0x40e18e3b9b374169U,
+  0x3d8fa01712e8f047U
+};
+
+// internal smallest mantissas which round up to 10 at 'prec' decimals (prec < 15), beyond that no double below 10 does
+static const double _etoa_round_up[15] = {
+  9.5, 9.950000000000001, 9.995000000000001, 9.999500000000001, 9.99995, 9.999995, 9.999999500000001,
+  9.999999950000001, 9.999999995000001, 9.999999999500002, 9.99999999995, 9.999999999995001, 9.9999999999995,
+  9.99999999999995, 9.999999999999996
+};
+
+
+// internal value * 10^-expval of the positive value mant * 2^exp2, 'mant' normalized to 53 bits
+// one table power 10^-a (a >= expval) and the exact 10^(a - expval), the binary exponents are added up front
+static double _etoa_scale(uint64_t mant, int exp2, int expval)
+{
+  union {
+    uint64_t U;
+    double   F;
+  } m, p, t;
+  const unsigned int i = (unsigned int)(expval + 335) / 16U;
+  const unsigned int r = (unsigned int)((int)(16U * i) - 320 - expval);
+  m.U = (mant & ((1ULL << 52U) - 1U)) | (1023ULL << 52U);
+  p.U = (_etoa_pow10[i] & ((1ULL << 52U) - 1U)) | (1023ULL << 52U);
+  t.U = (uint64_t)(exp2 + 52 + (int)(_etoa_pow10[i] >> 52U) - 2048 + 1023) << 52U;
+  return m.F * p.F * (double)(long long)_pow10_ull[r] * t.F;
+}
+
+
+// internal test whether the scaling error of up to about 2 ulp may decide the rounding of the scaled value
+// at 'prec' < 15 decimals, 'digits' stays below 2^53 so its integer part is exact
+static inline bool _etoa_near_tie(double scaled, unsigned int prec)
+{
+  const double digits = scaled * (double)_pow10_ull[prec];
+  const double margin = digits / 562949953421312.0;   // 2^49
+  const double half   = digits - (double)(unsigned long long)digits - 0.5;
+  return (half < margin) && (half > -margin);
+}
+
+
+// internal ftoa variant for exponential floating-point type, contributed by Martijn Jasperse <m.jasperse@gmail.com>
+PRINTF_ENGINE_SHARED static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  // check for NaN and special values
+  if ((value != value) || (value > DBL_MAX) || (value < -DBL_MAX)) {
+    return _ftoa(out, buffer, idx, maxlen, value, prec, width, flags);
+  }
+
+  // determine the sign
+  const bool negative = value < 0;
+  if (negative) {
+    value = -value;
+  }
+
+  // default precision
+  if (!(flags & FLAGS_PRECISION)) {
+    prec = PRINTF_DEFAULT_FLOAT_PRECISION;
+  }
+
+  // determine the decimal exponent, exact: floor(log2 * log10(2)) of the binary exponent is the decimal exponent
+  // or one below, which the scaled value tells
+  union {
+    uint64_t U;
+    double   F;
+  } conv;
+  conv.F = value;
+  int exp2;
+  uint64_t mant = _ftoa_decode(conv.U, &exp2);
+  int expval = 0;
+  double scaled = value;
+  if (mant) {
+    // subnormals are normalized to 53 bits
+#if defined(__GNUC__)
+    const int shift = __builtin_clzll(mant) - 11;
+    mant <<= shift;
+    exp2  -= shift;
+#else
+    while (!(mant >> 52U)) {
+      mant <<= 1U;
+      exp2--;
+    }
+#endif
+    const int lg2 = exp2 + 52;
+    expval = (lg2 >= 0) ? (int)(((unsigned int)lg2 * 78913U) >> 18U) : -(int)(((unsigned int)-lg2 * 78913U + 262143U) >> 18U);
+    scaled = _etoa_scale(mant, exp2, expval);
+    if (scaled >= 10.0) {
+      scaled = _etoa_scale(mant, exp2, ++expval);
+    }
+    if (scaled < 1.0) {
+      // rounding error of a value on a power of ten
+      scaled = 1.0;
+    }
+  }
+
+  // in "%g" mode, "prec" is the number of *significant figures* not decimals
+  if (flags & FLAGS_ADAPT_EXP) {
+    // do we want to fall-back to "%f" mode?
+    if ((expval >= -4) && (expval < 6)) {
+      if ((int)prec > expval) {
+        prec = (unsigned)((int)prec - expval - 1);
+      }
+      else {
+        prec = 0;
+      }
+      flags |= FLAGS_PRECISION;   // make sure _ftoa respects precision
+      return _ftoa(out, buffer, idx, maxlen, negative ? -value : value, prec, width, flags & ~FLAGS_ADAPT_EXP);
+    }
+    // we use one sigfig for the whole part
+    if ((prec > 0) && (flags & FLAGS_PRECISION)) {
+      --prec;
+    }
+  }
+
+  // the scaled value is only accurate to about 2 ulp: the digits beyond double precision, and the rounding of a
+  // value which is that close to a tie (e.g. an exact decimal tie), come from the exact conversion
+  if ((prec >= 15U) || _etoa_near_tie(scaled, prec)) {
+    return _etoa_exact(out, buffer, idx, maxlen, negative, mant, exp2, prec, width, flags);
+  }
+
+  // a mantissa rounding up to 10 is 1 of the next decade
+  if ((prec < 15U) && (scaled >= _etoa_round_up[prec])) {
+    scaled = 1.0;
+    expval++;
+  }
+
+  // the exponent format is "%+03d" and largest value is "308", so set aside 4-5 characters
+  const unsigned int minwidth = ((expval < 100) && (expval > -100)) ? 4U : 5U;
+
+  // will everything fit?
+  unsigned int fwidth = width;
+  if (width > minwidth) {
+    // subtract the characters required for the exponent
+    fwidth -= minwidth;
+  } else {
+    // not enough characters, so go back to default sizing
+    fwidth = 0U;
+  }
+  if (flags & FLAGS_LEFT) {
+    // if we're padding on the right, DON'T pad the floating part
+    fwidth = 0U;
+  }
+
+  // output the floating part
+  const size_t start_idx = idx;
+  idx = _ftoa(out, buffer, idx, maxlen, negative ? -scaled : scaled, prec, fwidth, flags & ~FLAGS_ADAPT_EXP);
+
+  // output the exponent part
+  // output the exponential symbol
+  out((flags & FLAGS_UPPERCASE) ? "E" : "e", 1U, buffer, idx++, maxlen);
+  // output the exponent value
+  idx = _ntoa_long(out, buffer, idx, maxlen, (expval < 0) ? -expval : expval, expval < 0, 10, 0, minwidth-1, FLAGS_ZEROPAD | FLAGS_PLUS);
+  // might need to right-pad spaces
+  if ((flags & FLAGS_LEFT) && (idx - start_idx < width)) {
+    idx = _out_spaces(out, buffer, idx, maxlen, width - (idx - start_idx));
+  }
+  return idx;
+}
+#endif  // PRINTF_FLOAT_INTEGER_ONLY
+#endif  // PRINTF_SUPPORT_EXPONENTIAL
+
+#if defined(PRINTF_SUPPORT_ROUNDTRIP)
+// Shortest round-trip notation (%r), the Ryu algorithm by Ulf Adams (https://github.com/ulfjack/ryu):
+// the interval of decimals rounding to the binary value is scaled by a power of 5 from a table of 128-bit
+// (float: 64-bit) multipliers, then digits are removed as long as the interval still holds a decimal.
+// The tables below are 5^-q * 2^(pow5bits(q) - 1 + 125) rounded up and 5^i * 2^(125 - pow5bits(i)) rounded
+// down (float: 59 and 61 bits)
+
+// internal ceil(log2(5^e)) for e > 0, 1 for e == 0
+static inline unsigned int _rtoa_pow5bits(unsigned int e)
+{
+  return ((e * 1217359U) >> 19U) + 1U;
+}
+
+// internal floor(log10(2^e))
+static inline unsigned int _rtoa_log10_pow2(unsigned int e)
+{
+  return (e * 78913U) >> 18U;
+}
+
+// internal floor(log10(5^e))
+static inline unsigned int _rtoa_log10_pow5(unsigned int e)
+{
+  return (e * 732923U) >> 20U;
+}
+
+// internal number of factors 5 of 'value'
+static inline unsigned int _rtoa_pow5_factor(uint64_t value)
+{
+  unsigned int count = 0U;
+  for (; !(value % 5U); value /= 5U) {
+    ++count;
+  }
+  return count;
+}
+
+
+// internal float tables
+static const uint64_t _rtoa_pow5_inv32[31] = {
+  0x0800000000000001ULL, 0x0666666666666667ULL, 0x051eb851eb851eb9ULL,
+  0x04189374bc6a7efaULL, 0x068db8bac710cb2aULL, 0x053e2d6238da3c22ULL,
+  0x0431bde82d7b634eULL, 0x06b5fca6af2bd216ULL, 0x055e63b88c230e78ULL,
+  0x044b82fa09b5a52dULL, 0x06df37f675ef6eaeULL, 0x057f5ff85e592558ULL,
+  0x0465e6604b7a8447ULL, 0x0709709a125da071ULL, 0x05a126e1a84ae6c1ULL,
+  0x0480ebe7b9d58567ULL, 0x0734aca5f6226f0bULL, 0x05c3bd5191b525a3ULL,
+  0x049c97747490eae9ULL, 0x0760f253edb4ab0eULL, 0x05e72843249088d8ULL,
+  0x04b8ed0283a6d3e0ULL, 0x078e480405d7b966ULL, 0x060b6cd004ac9452ULL,
+  0x04d5f0a66a23a9dbULL, 0x07bcb43d769f762bULL, 0x063090312bb2c4efULL,
+  0x04f3a68dbc8f03f3ULL, 0x07ec3daf94180651ULL, 0x065697bfa9acd1daULL,
+  0x051212ffbaf0a7e2ULL
+};
+static const uint64_t _rtoa_pow5_32[48] = {
+  0x1000000000000000ULL, 0x1400000000000000ULL, 0x1900000000000000ULL,
+  0x1f40000000000000ULL, 0x1388000000000000ULL, 0x186a000000000000ULL,
+  0x1e84800000000000ULL, 0x1312d00000000000ULL, 0x17d7840000000000ULL,
+  0x1dcd650000000000ULL, 0x12a05f2000000000ULL, 0x174876e800000000ULL,
+  0x1d1a94a200000000ULL, 0x12309ce540000000ULL, 0x16bcc41e90000000ULL,
+  0x1c6bf52634000000ULL, 0x11c37937e0800000ULL, 0x16345785d8a00000ULL,
+  0x1bc16d674ec80000ULL, 0x1158e460913d0000ULL, 0x15af1d78b58c4000ULL,
+  0x1b1ae4d6e2ef5000ULL, 0x10f0cf064dd59200ULL, 0x152d02c7e14af680ULL,
+  0x1a784379d99db420ULL, 0x108b2a2c28029094ULL, 0x14adf4b7320334b9ULL,
+  0x19d971e4fe8401e7ULL, 0x1027e72f1f128130ULL, 0x1431e0fae6d7217cULL,
+  0x193e5939a08ce9dbULL, 0x1f8def8808b02452ULL, 0x13b8b5b5056e16b3ULL,
+  0x18a6e32246c99c60ULL, 0x1ed09bead87c0378ULL, 0x13426172c74d822bULL,
+  0x1812f9cf7920e2b6ULL, 0x1e17b84357691b64ULL, 0x12ced32a16a1b11eULL,
+  0x178287f49c4a1d66ULL, 0x1d6329f1c35ca4bfULL, 0x125dfa371a19e6f7ULL,
+  0x16f578c4e0a060b5ULL, 0x1cb2d6f618c878e3ULL, 0x11efc659cf7d4b8dULL,
+  0x166bb7f0435c9e71ULL, 0x1c06a5ec5433c60dULL, 0x118427b3b4a05bc8ULL
+};
+
+
+// internal (m * mul) >> shift of a 32 bit value and a 64-bit multiplier, 'shift' is above 32
+static inline uint32_t _rtoa_mul_shift32(uint32_t m, uint64_t mul, unsigned int shift)
+{
+  const uint64_t lo = (uint64_t)m * (uint32_t)mul;
+  const uint64_t hi = (uint64_t)m * (uint32_t)(mul >> 32U);
+  return (uint32_t)(((lo >> 32U) + hi) >> (shift - 32U));
+}
+
+
+// internal shortest decimal of a finite, positive float in its IEEE-754 bits, value = digits * 10^exp10
+static uint32_t _rtoa_shortest32(uint32_t bits, int* exp10)
+{
+  const uint32_t ieee_mant = bits & ((1U << 23U) - 1U);
+  const uint32_t ieee_exp  = bits >> 23U;
+  const int      e2  = (ieee_exp ? (int)ieee_exp : 1) - 127 - 23 - 2;
+  const uint32_t m2  = ieee_exp ? (1U << 23U) | ieee_mant : ieee_mant;
+  const bool     accept_bounds = !(m2 & 1U);
+
+  // the interval [mm, mp] of values rounding to m2, all times 4
+  const uint32_t mv = 4U * m2;
+  const uint32_t mp = 4U * m2 + 2U;
+  const uint32_t mm = 4U * m2 - 1U - ((ieee_mant || (ieee_exp <= 1U)) ? 1U : 0U);
+
+  uint32_t vr, vp, vm;
+  int e10;
+  bool vm_trailing_zeros = false, vr_trailing_zeros = false;
+  uint32_t last_removed = 0U;
+  if (e2 >= 0) {
+    const unsigned int q = _rtoa_log10_pow2((unsigned int)e2);
+    const unsigned int i = q + 59U + _rtoa_pow5bits(q) - 1U - (unsigned int)e2;
+    e10 = (int)q;
+    vr = _rtoa_mul_shift32(mv, _rtoa_pow5_inv32[q], i);
+    vp = _rtoa_mul_shift32(mp, _rtoa_pow5_inv32[q], i);
+    vm = _rtoa_mul_shift32(mm, _rtoa_pow5_inv32[q], i);
+    if (q && ((vp - 1U) / 10U <= vm / 10U)) {
+      // the loop below removes no digit, the last removed one is needed for rounding
+      const unsigned int l = q - 1U + 59U + _rtoa_pow5bits(q - 1U) - 1U - (unsigned int)e2;
+      last_removed = _rtoa_mul_shift32(mv, _rtoa_pow5_inv32[q - 1U], l) % 10U;
+    }
+    if (q <= 9U) {
+      // only one of mp, mv and mm can be a multiple of 5
+      if (!(mv % 5U)) {
+        vr_trailing_zeros = _rtoa_pow5_factor(mv) >= q;
+      }
+      else if (accept_bounds) {
+        vm_trailing_zeros = _rtoa_pow5_factor(mm) >= q;
+      }
+      else {
+        vp -= (_rtoa_pow5_factor(mp) >= q) ? 1U : 0U;
+      }
+    }
+  }
+  else {
+    const unsigned int q = _rtoa_log10_pow5((unsigned int)-e2);
+    const unsigned int i = (unsigned int)-e2 - q;
+    const unsigned int j = q + 61U - _rtoa_pow5bits(i);
+    e10 = (int)q + e2;
+    vr = _rtoa_mul_shift32(mv, _rtoa_pow5_32[i], j);
+    vp = _rtoa_mul_shift32(mp, _rtoa_pow5_32[i], j);
+    vm = _rtoa_mul_shift32(mm, _rtoa_pow5_32[i], j);
+    if (q && ((vp - 1U) / 10U <= vm / 10U)) {
+      const unsigned int l = q - 1U + 61U - _rtoa_pow5bits(i + 1U);
+      last_removed = _rtoa_mul_shift32(mv, _rtoa_pow5_32[i + 1U], l) % 10U;
+    }
+    if (q <= 1U) {
+      // mv = 4 * m2 has at least 2 trailing zero bits
+      vr_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_trailing_zeros = mm == mv - 2U;
+      }
+      else {
+        --vp;
+      }
+    }
+    else if (q < 31U) {
+      vr_trailing_zeros = !(mv & ((1U << (q - 1U)) - 1U));
+    }
+  }
+
+  // remove the digits while the interval still holds a shorter decimal
+  int removed = 0;
+  if (vm_trailing_zeros || vr_trailing_zeros) {
+    // rare, the interval bounds or the value may be exact
+    while (vp / 10U > vm / 10U) {
+      vm_trailing_zeros &= !(vm % 10U);
+      vr_trailing_zeros &= !last_removed;
+      last_removed = vr % 10U;
+      vr /= 10U; vp /= 10U; vm /= 10U;
+      ++removed;
+    }
+    if (vm_trailing_zeros) {
+      while (!(vm % 10U)) {
+        vr_trailing_zeros &= !last_removed;
+        last_removed = vr % 10U;
+        vr /= 10U; vp /= 10U; vm /= 10U;
+        ++removed;
+      }
+    }
+    if (vr_trailing_zeros && (last_removed == 5U) && !(vr & 1U)) {
+      // exactly halfway, round to even
+      last_removed = 4U;
+    }
+    *exp10 = e10 + removed;
+    return vr + ((((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) || (last_removed >= 5U)) ? 1U : 0U);
+  }
+  while (vp / 10U > vm / 10U) {
+    last_removed = vr % 10U;
+    vr /= 10U; vp /= 10U; vm /= 10U;
+    ++removed;
+  }
+  *exp10 = e10 + removed;
+  return vr + (((vr == vm) || (last_removed >= 5U)) ? 1U : 0U);
+}
+
+
+#if defined(PRINTF_SUPPORT_ROUNDTRIP_DOUBLE)
+// internal double tables
+static const uint64_t _rtoa_pow5_inv[291][2] = {
+  { 0x0000000000000001ULL, 0x2000000000000000ULL }, { 0x999999999999999aULL, 0x1999999999999999ULL },
+  { 0x47ae147ae147ae15ULL, 0x147ae147ae147ae1ULL }, { 0x6c8b4395810624deULL, 0x10624dd2f1a9fbe7ULL },
+  { 0x7a786c226809d496ULL, 0x1a36e2eb1c432ca5ULL }, { 0x61f9f01b866e43abULL, 0x14f8b588e368f084ULL },
+  { 0xb4c7f34938583622ULL, 0x10c6f7a0b5ed8d36ULL }, { 0x87a6520ec08d236aULL, 0x1ad7f29abcaf4857ULL },
+  { 0x9fb841a566d74f88ULL, 0x15798ee2308c39dfULL }, { 0xe62d01511f12a607ULL, 0x112e0be826d694b2ULL },
+  { 0xd6ae6881cb5109a4ULL, 0x1b7cdfd9d7bdbab7ULL }, { 0xdef1ed34a2a73aeaULL, 0x15fd7fe17964955fULL },
+  { 0x7f27f0f6e885c8bbULL, 0x119799812dea1119ULL }, { 0x650cb4be40d60df8ULL, 0x1c25c268497681c2ULL },
+  { 0xea70909833de7193ULL, 0x16849b86a12b9b01ULL }, { 0x21f3a6e0297ec143ULL, 0x1203af9ee756159bULL },
+  { 0x6985d7cd0f313537ULL, 0x1cd2b297d889bc2bULL }, { 0x2137dfd73f5a90f9ULL, 0x170ef54646d49689ULL },
+  { 0xe75fe645cc4873faULL, 0x12725dd1d243aba0ULL }, { 0xa5663d3c7a0d865dULL, 0x1d83c94fb6d2ac34ULL },
+  { 0x511e976394d79eb1ULL, 0x179ca10c9242235dULL }, { 0xda7edf82dd794bc1ULL, 0x12e3b40a0e9b4f7dULL },
+  { 0x2a6498d1625bac68ULL, 0x1e392010175ee596ULL }, { 0xeeb6e0a781e2f053ULL, 0x182db34012b25144ULL },
+  { 0x58924d52ce4f26a9ULL, 0x1357c299a88ea76aULL }, { 0x27507bb7b07ea441ULL, 0x1ef2d0f5da7dd8aaULL },
+  { 0x52a6c95fc0655034ULL, 0x18c240c4aecb13bbULL }, { 0x0eebd44c99eaa690ULL, 0x13ce9a36f23c0fc9ULL },
+  { 0xb17953adc3110a80ULL, 0x1fb0f6be50601941ULL }, { 0xc12ddc8b02740867ULL, 0x195a5efea6b34767ULL },
+  { 0x3424b06f3529a052ULL, 0x14484bfeebc29f86ULL }, { 0x901d59f290ee19dbULL, 0x1039d66589687f9eULL },
+  { 0x4cfbc31db4b0295fULL, 0x19f623d5a8a73297ULL }, { 0x3d9635b15d59bab2ULL, 0x14c4e977ba1f5bacULL },
+  { 0x97ab5e277de16228ULL, 0x109d8792fb4c4956ULL }, { 0xf2abc9d8c9689d0dULL, 0x1a95a5b7f87a0ef0ULL },
+  { 0x5bbca17a3aba173eULL, 0x154484932d2e725aULL }, { 0xafca1ac82efb45cbULL, 0x11039d428a8b8eaeULL },
+  { 0xb2dcf7a6b1920945ULL, 0x1b38fb9daa78e44aULL }, { 0xf57d92ebc141a104ULL, 0x15c72fb1552d836eULL },
+  { 0xc46475896767b403ULL, 0x116c262777579c58ULL }, { 0x6d6d88dbd8a5ecd2ULL, 0x1be03d0bf225c6f4ULL },
+  { 0x8abe071646eb23dbULL, 0x164cfda3281e38c3ULL }, { 0x6efe6c11d255b649ULL, 0x11d7314f534b609cULL },
+  { 0xb197134fb6ef8a0eULL, 0x1c8b821885456760ULL }, { 0x27ac0f72f8bfa1a5ULL, 0x16d601ad376ab91aULL },
+  { 0xb95672c260994e1eULL, 0x1244ce242c5560e1ULL }, { 0xf5571e03cdc21695ULL, 0x1d3ae36d13bbce35ULL },
+  { 0x2aac18030b01ababULL, 0x17624f8a762fd82bULL }, { 0xbbbce0026f348956ULL, 0x12b50c6ec4f31355ULL },
+  { 0x92c7ccd0b1eda889ULL, 0x1dee7a4ad4b81eefULL }, { 0xdbd30a408e57ba07ULL, 0x17f1fb6f10934bf2ULL },
+  { 0x7ca8d50071dfc806ULL, 0x1327fc58da0f6ff5ULL }, { 0xfaa7bb33e9660cd6ULL, 0x1ea6608e29b24cbbULL },
+  { 0x9552fc298784d711ULL, 0x18851a0b548ea3c9ULL }, { 0xaaa8c9bad2d0ac0eULL, 0x139dae6f76d88307ULL },
+  { 0xdddadc5e1e1aace3ULL, 0x1f62b0b257c0d1a5ULL }, { 0x7e48b04b4b488a4fULL, 0x191bc08eac9a4151ULL },
+  { 0xcb6d59d5d5d3a1d9ULL, 0x141633a556e1cddaULL }, { 0x3c577b1177dc817bULL, 0x1011c2eaabe7d7e2ULL },
+  { 0xc6f25e825960cf2aULL, 0x19b604aaaca62636ULL }, { 0x6bf518684780a5bbULL, 0x14919d5556eb51c5ULL },
+  { 0x232a79ed06008496ULL, 0x10747ddddf22a7d1ULL }, { 0xd1dd8fe1a3340756ULL, 0x1a53fc9631d10c81ULL },
+  { 0xa7e4731ae8f66c45ULL, 0x150ffd44f4a73d34ULL }, { 0x531d28e253f8569eULL, 0x10d9976a5d52975dULL },
+  { 0xeb61db03b98d5762ULL, 0x1af5bf109550f22eULL }, { 0xbc4e48cfc7a445e8ULL, 0x159165a6ddda5b58ULL },
+  { 0x6371d3d96c836b20ULL, 0x11411e1f17e1e2adULL }, { 0x9f1c8628ad9f11cdULL, 0x1b9b6364f3030448ULL },
+  { 0xe5b06b53be18db0bULL, 0x1615e91d8f359d06ULL }, { 0xeaf3890fcb4715a2ULL, 0x11ab20e472914a6bULL },
+  { 0x44b8db4c7871bc37ULL, 0x1c45016d841baa46ULL }, { 0x03c715d6c6c1635fULL, 0x169d9abe03495505ULL },
+  { 0x3638de456bcde919ULL, 0x1217aefe69077737ULL }, { 0x56c163a2461641c1ULL, 0x1cf2b1970e725858ULL },
+  { 0xdf011c81d1ab67ceULL, 0x17288e1271f51379ULL }, { 0x7f3416ce4155eca5ULL, 0x1286d80ec190dc61ULL },
+  { 0x6520247d3556476eULL, 0x1da48ce468e7c702ULL }, { 0xea801d30f7783925ULL, 0x17b6d71d20b96c01ULL },
+  { 0xbb99b0f3f92cfa84ULL, 0x12f8ac174d612334ULL }, { 0x5f5c4e532847f739ULL, 0x1e5aacf215683854ULL },
+  { 0x7f7d0b75b9d32c2eULL, 0x18488a5b44536043ULL }, { 0x9930d5f7c7dc2358ULL, 0x136d3b7c36a919cfULL },
+  { 0x8eb4898c72f9d226ULL, 0x1f152bf9f10e8fb2ULL }, { 0x722a07a38f2e41b8ULL, 0x18ddbcc7f40ba628ULL },
+  { 0xc1bb394fa5be9afaULL, 0x13e497065cd61e86ULL }, { 0x9c5ec2190930f7f6ULL, 0x1fd424d6faf030d7ULL },
+  { 0x49e56814075a5ff8ULL, 0x197683df2f268d79ULL }, { 0x6e51201005e1e660ULL, 0x145ecfe5bf520ac7ULL },
+  { 0xf1da800cd181851aULL, 0x104bd984990e6f05ULL }, { 0x4fc400148268d4f5ULL, 0x1a12f5a0f4e3e4d6ULL },
+  { 0xd96999aa01ed772bULL, 0x14dbf7b3f71cb711ULL }, { 0xadee1488018ac5bcULL, 0x10aff95cc5b09274ULL },
+  { 0x497ceda668de092cULL, 0x1ab328946f80ea54ULL }, { 0x3aca57b853e4d424ULL, 0x155c2076bf9a5510ULL },
+  { 0x623b7960431d7683ULL, 0x1116805effaeaa73ULL }, { 0x9d2bf566d1c8bd9eULL, 0x1b5733cb32b110b8ULL },
+  { 0x7dbcc452416d647fULL, 0x15df5ca28ef40d60ULL }, { 0xcafd69db678ab6ccULL, 0x117f7d4ed8c33de6ULL },
+  { 0xab2f0fc572778adfULL, 0x1bff2ee48e052fd7ULL }, { 0x88f273045b92d580ULL, 0x1665bf1d3e6a8cacULL },
+  { 0xd3f528d049424466ULL, 0x11eaff4a98553d56ULL }, { 0xb988414d4203a0a3ULL, 0x1cab3210f3bb9557ULL },
+  { 0x6139cdd76802e6e9ULL, 0x16ef5b40c2fc7779ULL }, { 0xe761717920025254ULL, 0x125915cd68c9f92dULL },
+  { 0xa568b58e999d5086ULL, 0x1d5b561574765b7cULL }, { 0x5120913ee14aa6d2ULL, 0x177c44ddf6c515fdULL },
+  { 0xa74d40ff1aa21f0eULL, 0x12c9d0b1923744caULL }, { 0x0baece64f769cb4aULL, 0x1e0fb44f50586e11ULL },
+  { 0x3c8bd850c5ee3c3bULL, 0x180c903f7379f1a7ULL }, { 0xca0979da37f1c9c9ULL, 0x133d4032c2c7f485ULL },
+  { 0xa9a8c2f6bfe942dbULL, 0x1ec866b79e0cba6fULL }, { 0x2153cf2bccba9be3ULL, 0x18a0522c7e709526ULL },
+  { 0x1aa9728970954982ULL, 0x13b374f06526ddb8ULL }, { 0xf775840f1a88759dULL, 0x1f8587e7083e2f8cULL },
+  { 0x5f9136727ba05e17ULL, 0x19379fec0698260aULL }, { 0x1940f85b9619e4dfULL, 0x142c7ff0054684d5ULL },
+  { 0xe100c6afab47ea4cULL, 0x1023998cd1053710ULL }, { 0xce67a44c453fdd47ULL, 0x19d28f47b4d524e7ULL },
+  { 0xd852e9d69dccb106ULL, 0x14a8729fc3ddb71fULL }, { 0x79dbee454b0a2738ULL, 0x1086c219697e2c19ULL },
+  { 0x295fe3a211a9d859ULL, 0x1a71368f0f30468fULL }, { 0xbab31c81a7bb137aULL, 0x15275ed8d8f36ba5ULL },
+  { 0x6228e39aec95a92fULL, 0x10ec4be0ad8f8951ULL }, { 0x9d0e38f7e0ef7517ULL, 0x1b13ac9aaf4c0ee8ULL },
+  { 0xb0d82d931a592a79ULL, 0x15a956e225d67253ULL }, { 0x8d79be0f4847552eULL, 0x11544581b7dec1dcULL },
+  { 0x158f967eda0bbb7cULL, 0x1bba08cf8c979c94ULL }, { 0x77a611ff14d62f97ULL, 0x162e6d72d6dfb076ULL },
+  { 0xf951a7ff43de8c79ULL, 0x11bebdf578b2f391ULL }, { 0xc21c3ffed2fdad8eULL, 0x1c6463225ab7ec1cULL },
+  { 0x01b0333242648ad8ULL, 0x16b6b5b5155ff017ULL }, { 0x0159c28e9b83a246ULL, 0x122bc490dde659acULL },
+  { 0xcef604175f3903a3ULL, 0x1d12d41afca3c2acULL }, { 0x725e69ac4c2d9c83ULL, 0x17424348ca1c9bbdULL },
+  { 0xf5185489d68ae39cULL, 0x129b69070816e2fdULL }, { 0xee8d540fbdab05c6ULL, 0x1dc574d80cf16b2fULL },
+  { 0xbed77672fe226b05ULL, 0x17d12a4670c1228cULL }, { 0xff12c528cb4ebc04ULL, 0x130dbb6b8d674ed6ULL },
+  { 0xcb513b74787df9a0ULL, 0x1e7c5f127bd87e24ULL }, { 0x090dc929f9fe614dULL, 0x18637f41fcad31b7ULL },
+  { 0xa0d7d42194cb810aULL, 0x1382cc34ca2427c5ULL }, { 0x67bfb9cf5478ce77ULL, 0x1f37ad21436d0c6fULL },
+  { 0x1fcc94a5dd2d71f9ULL, 0x18f9574dcf8a7059ULL }, { 0x7fd6dd517dbdf4c7ULL, 0x13faac3e3fa1f37aULL },
+  { 0xffbe2ee8c92fee0bULL, 0x1ff779fd329cb8c3ULL }, { 0x6631bf20a0f324d6ULL, 0x1992c7fdc216fa36ULL },
+  { 0xb827cc1a1a5c1d78ULL, 0x14756ccb01abfb5eULL }, { 0x935309ae7b7ce460ULL, 0x105df0a267bcc918ULL },
+  { 0x1eeb42b0c594a099ULL, 0x1a2fe76a3f9474f4ULL }, { 0xe58902270476e6e1ULL, 0x14f31f8832dd2a5cULL },
+  { 0xb7a0ce859d2bebe7ULL, 0x10c27fa028b0eeb0ULL }, { 0x59014a6f61dfdfd8ULL, 0x1ad0cc33744e4ab4ULL },
+  { 0xe0cdd525e7e64cadULL, 0x1573d68f903ea229ULL }, { 0x4d7177518651d6f1ULL, 0x11297872d9cbb4eeULL },
+  { 0x7be8bee8d6e957e8ULL, 0x1b758d848fac54b0ULL }, { 0xfcba3253df211320ULL, 0x15f7a46a0c89dd59ULL },
+  { 0x63c8284318e74280ULL, 0x1192e9ee706e4aaeULL }, { 0x060d0d3827d86a66ULL, 0x1c1e43171a4a1117ULL },
+  { 0x6b3da42cecad21ebULL, 0x167e9c127b6e7412ULL }, { 0x88fe1cf0bd574e56ULL, 0x11fee341fc585cdbULL },
+  { 0x419694b462254a23ULL, 0x1ccb0536608d615fULL }, { 0x67abaa29e81dd4e9ULL, 0x1708d0f84d3de77fULL },
+  { 0xb95621bb2017dd87ULL, 0x126d73f9d764b932ULL }, { 0xc223692b668c95a5ULL, 0x1d7becc2f23ac1eaULL },
+  { 0xce82ba891ed6de1dULL, 0x179657025b6234bbULL }, { 0xa53562074bdf1818ULL, 0x12deac01e2b4f6fcULL },
+  { 0x3b889cd87964f359ULL, 0x1e3113363787f194ULL }, { 0xfc6d4a46c783f5e1ULL, 0x18274291c6065adcULL },
+  { 0x30576e9f06032b1aULL, 0x13529ba7d19eaf17ULL }, { 0x1a257dcb3cd1de90ULL, 0x1eea92a61c311825ULL },
+  { 0x481dfe3c30a7e540ULL, 0x18bba884e35a79b7ULL }, { 0xd34b31c9c0865100ULL, 0x13c9539d82aec7c5ULL },
+  { 0x5211e942cda3b4cdULL, 0x1fa885c8d117a609ULL }, { 0x74db21023e1c90a4ULL, 0x19539e3a40dfb807ULL },
+  { 0xf715b401cb4a0d50ULL, 0x1442e4fb67196005ULL }, { 0xf8de299b09080aa7ULL, 0x103583fc527ab337ULL },
+  { 0x8e304291a80cddd7ULL, 0x19ef3993b72ab859ULL }, { 0x3e8d020e200a4b13ULL, 0x14bf6142f8eef9e1ULL },
+  { 0x653d9b3e80083c0fULL, 0x10991a9bfa58c7e7ULL }, { 0x6ec8f864000d2ce4ULL, 0x1a8e90f9908e0ca5ULL },
+  { 0x8bd3f9e999a423eaULL, 0x153eda614071a3b7ULL }, { 0x3ca994bae1501cbbULL, 0x10ff151a99f482f9ULL },
+  { 0xc775bac49bb3612bULL, 0x1b31bb5dc320d18eULL }, { 0xd2c4956a16291a89ULL, 0x15c162b168e70e0bULL },
+  { 0xdbd0778811ba7ba1ULL, 0x11678227871f3e6fULL }, { 0x2c80bf401c5d929bULL, 0x1bd8d03f3e9863e6ULL },
+  { 0xbd33cc3349e47549ULL, 0x16470cff6546b651ULL }, { 0xca8fd68f6e505dd4ULL, 0x11d270cc51055ea7ULL },
+  { 0x4419574be3b3c953ULL, 0x1c83e7ad4e6efdd9ULL }, { 0x0347790982f63aa9ULL, 0x16cfec8aa52597e1ULL },
+  { 0xcf6c60d468c4fbbaULL, 0x123ff06eea847980ULL }, { 0xe57a34870e07f92aULL, 0x1d331a4b10d3f59aULL },
+  { 0x512e906c0b399422ULL, 0x175c1508da432ae2ULL }, { 0xda8ba6bcd5c7a9b5ULL, 0x12b010d3e1cf5581ULL },
+  { 0x90df712e22d90f87ULL, 0x1de6815302e5559cULL }, { 0xda4c5a8b4f140c6cULL, 0x17eb9aa8cf1dde16ULL },
+  { 0xaea37ba2a5a9a38aULL, 0x1322e220a5b17e78ULL }, { 0x7dd25f6aa2a905a9ULL, 0x1e9e369aa2b59727ULL },
+  { 0x97db7f888220d154ULL, 0x187e92154ef7ac1fULL }, { 0x797c6606ce80a777ULL, 0x139874ddd8c6234cULL },
+  { 0x8f2d700ae4010bf1ULL, 0x1f5a549627a36badULL }, { 0x0c2459a25000d65aULL, 0x191510781fb5efbeULL },
+  { 0x701d1481d99a4515ULL, 0x1410d9f9b2f7f2feULL }, { 0xc017439b147b6a77ULL, 0x100d7b2e28c65bfeULL },
+  { 0xccf205c4ed9243f2ULL, 0x19af2b7d0e0a2ccaULL }, { 0x0a5b37d0be0e9cc2ULL, 0x148c22ca71a1bd6fULL },
+  { 0x0848f973cb3ee3ceULL, 0x10701bd527b4978cULL }, { 0xda0e5bec78649fb0ULL, 0x1a4cf9550c5425acULL },
+  { 0x7b3eaff060507fc0ULL, 0x150a6110d6a9b7bdULL }, { 0x95cbbff380406633ULL, 0x10d51a73deee2c97ULL },
+  { 0xefac665266cd7052ULL, 0x1aee90b964b04758ULL }, { 0x2623850eb8a459dbULL, 0x158ba6fab6f36c47ULL },
+  { 0x1e82d0d893b6ae49ULL, 0x113c85955f29236cULL }, { 0xfd9e1af41f8ab075ULL, 0x1b9408eefea838acULL },
+  { 0x97b1af29b2d559f7ULL, 0x16100725988693bdULL }, { 0xac8e25baf5777b2cULL, 0x11a66c1e139edc97ULL },
+  { 0x7a7d092b2258c513ULL, 0x1c3d79c9b8fe2dbfULL }, { 0x61fda0ef4ead6a76ULL, 0x169794a160cb57ccULL },
+  { 0xe7fe1a590bbdeec5ULL, 0x1212dd4de7091309ULL }, { 0xa6635d5b45fcb13aULL, 0x1ceafbafd80e84dcULL },
+  { 0x851c4aaf6b308dc8ULL, 0x172262f3133ed0b0ULL }, { 0xd0e36ef2bc26d7d4ULL, 0x1281e8c275cbda26ULL },
+  { 0xb49f17eac6a48c86ULL, 0x1d9ca79d894629d7ULL }, { 0x2a18dfef0550706bULL, 0x17b08617a104ee46ULL },
+  { 0x54e0b3259dd9f389ULL, 0x12f39e794d9d8b6bULL }, { 0x87cdeb6f62f65274ULL, 0x1e5297287c2f4578ULL },
+  { 0xd30b22bf825ea85dULL, 0x18421286c9bf6ac6ULL }, { 0x0f3c1bcc684bb9e4ULL, 0x13680ed23aff889fULL },
+  { 0x18602c7a4079296dULL, 0x1f0ce4839198da98ULL }, { 0x46b356c833942124ULL, 0x18d71d360e13e213ULL },
+  { 0x388f78a029434db6ULL, 0x13df4a91a4dcb4dcULL }, { 0x5a7f2766a86baf8aULL, 0x1fcbaa82a1612160ULL },
+  { 0x153285ebb9efbfa2ULL, 0x196fbb9bb44db44dULL }, { 0xaa8ed189618c994eULL, 0x145962e2f6a4903dULL },
+  { 0xeed8a7a11ad6e10cULL, 0x1047824f2bb6d9caULL }, { 0x7e27729b5e249b45ULL, 0x1a0c03b1df8af611ULL },
+  { 0xfe85f549181d4904ULL, 0x14d6695b193bf80dULL }, { 0xcb9e5dd4134aa0d0ULL, 0x10ab877c142ff9a4ULL },
+  { 0xdf63c9535211014dULL, 0x1aac0bf9b9e65c3aULL }, { 0x191ca10f74da6771ULL, 0x15566ffafb1eb02fULL },
+  { 0xadb080d92a4852c1ULL, 0x1111f32f2f4bc025ULL }, { 0x15e7348eaa0d5134ULL, 0x1b4feb7eb212cd09ULL },
+  { 0xab1f5d3eee710dc4ULL, 0x15d98932280f0a6dULL }, { 0xbc1917658b8da49dULL, 0x117ad428200c0857ULL },
+  { 0x2cf4f23c127c3a94ULL, 0x1bf7b9d9cce00d59ULL }, { 0xf0c3f4fcdb969543ULL, 0x165fc7e170b33de0ULL },
+  { 0x5a365d9716121103ULL, 0x11e6398126f5cb1aULL }, { 0x9056fc24f01ce804ULL, 0x1ca38f350b22de90ULL },
+  { 0xd9df301d8ce3ecd0ULL, 0x16e93f5da2824ba6ULL }, { 0xe17f59b13d8323daULL, 0x125432b14ecea2ebULL },
+  { 0x68cbc2b52f38395cULL, 0x1d53844ee47dd179ULL }, { 0x53d6355dbf602de3ULL, 0x177603725064a794ULL },
+  { 0xa9782ab165e68b1cULL, 0x12c4cf8ea6b6ec76ULL }, { 0x0f26aab56fd744faULL, 0x1e07b27dd78b13f1ULL },
+  { 0x3f52222abfdf6a62ULL, 0x18062864ac6f4327ULL }, { 0x65db4e88997f884eULL, 0x1338205089f29c1fULL },
+  { 0x6fc54a7428cc0d4aULL, 0x1ec033b40fea9365ULL }, { 0x596aa1f68709a43bULL, 0x1899c2f673220f84ULL },
+  { 0xadeee7f86c07b696ULL, 0x13ae3591f5b4d936ULL }, { 0x497e3ff3e00c5756ULL, 0x1f7d228322baf524ULL },
+  { 0xd464fff64cd6ac45ULL, 0x1930e868e89590e9ULL }, { 0x4383fff83d7889d1ULL, 0x14272053ed4473eeULL },
+  { 0xcf9cccc69793a174ULL, 0x101f4d0ff1038ff1ULL }, { 0x7f6147a425b90252ULL, 0x19cbae7fe805b31cULL },
+  { 0xcc4dd2e9b7c7350fULL, 0x14a2f1ffecd15c16ULL }, { 0x3d0b0f215fd290d9ULL, 0x10825b3323dab012ULL },
+  { 0x61ab4b689950e7c1ULL, 0x1a6a2b85062ab350ULL }, { 0x4e22a2ba1440b967ULL, 0x1521bc6a6b555c40ULL },
+  { 0x0b4ee894dd009453ULL, 0x10e7c9eebc4449cdULL }, { 0x1217da87c800ed51ULL, 0x1b0c764ac6d3a948ULL },
+  { 0xdb46486ca000bddaULL, 0x15a391d56bdc876cULL }, { 0x490506bd4ccd64afULL, 0x114fa7ddefe39f8aULL },
+  { 0xa8080ac87ae23ab1ULL, 0x1bb2a62fe638ff43ULL }, { 0x5339a239fbe82ef4ULL, 0x162884f31e93ff69ULL },
+  { 0x75c7b4fb2fecf25dULL, 0x11ba03f5b20fff87ULL }, { 0x22d92191e647ea2eULL, 0x1c5cd322b67fff3fULL },
+  { 0xb57a8141850654f2ULL, 0x16b0a8e891ffff65ULL }, { 0xc4620101373843f5ULL, 0x1226ed86db3332b7ULL },
+  { 0x3a366801f1f39feeULL, 0x1d0b15a491eb8459ULL }, { 0xfb5eb99b27f6198bULL, 0x173c115074bc69e0ULL },
+  { 0x2f7efae2865e7ad6ULL, 0x129674405d6387e7ULL }, { 0xe597f7d0d6fd9156ULL, 0x1dbd86cd6238d971ULL },
+  { 0x8479930d78cadaabULL, 0x17cad23de82d7ac1ULL }, { 0xd06142712d6f1556ULL, 0x1308a831868ac89aULL },
+  { 0x4d686a4eaf182222ULL, 0x1e74404f3daada91ULL }, { 0xa453883ef279b4e8ULL, 0x185d003f6488aedaULL },
+  { 0xe9dc6cff28615d87ULL, 0x137d99cc506d58aeULL }, { 0xa960ae650d6895a4ULL, 0x1f2f5c7a1a488de4ULL },
+  { 0xbab3beb73ded4483ULL, 0x18f2b061aea07183ULL }
+};
+static const uint64_t _rtoa_pow5[326][2] = {
+  { 0x0000000000000000ULL, 0x1000000000000000ULL }, { 0x0000000000000000ULL, 0x1400000000000000ULL },
+  { 0x0000000000000000ULL, 0x1900000000000000ULL }, { 0x0000000000000000ULL, 0x1f40000000000000ULL },
+  { 0x0000000000000000ULL, 0x1388000000000000ULL }, { 0x0000000000000000ULL, 0x186a000000000000ULL },
+  { 0x0000000000000000ULL, 0x1e84800000000000ULL }, { 0x0000000000000000ULL, 0x1312d00000000000ULL },
+  { 0x0000000000000000ULL, 0x17d7840000000000ULL }, { 0x0000000000000000ULL, 0x1dcd650000000000ULL },
+  { 0x0000000000000000ULL, 0x12a05f2000000000ULL }, { 0x0000000000000000ULL, 0x174876e800000000ULL },
+  { 0x0000000000000000ULL, 0x1d1a94a200000000ULL }, { 0x0000000000000000ULL, 0x12309ce540000000ULL },
+  { 0x0000000000000000ULL, 0x16bcc41e90000000ULL }, { 0x0000000000000000ULL, 0x1c6bf52634000000ULL },
+  { 0x0000000000000000ULL, 0x11c37937e0800000ULL }, { 0x0000000000000000ULL, 0x16345785d8a00000ULL },
+  { 0x0000000000000000ULL, 0x1bc16d674ec80000ULL }, { 0x0000000000000000ULL, 0x1158e460913d0000ULL },
+  { 0x0000000000000000ULL, 0x15af1d78b58c4000ULL }, { 0x0000000000000000ULL, 0x1b1ae4d6e2ef5000ULL },
+  { 0x0000000000000000ULL, 0x10f0cf064dd59200ULL }, { 0x0000000000000000ULL, 0x152d02c7e14af680ULL },
+  { 0x0000000000000000ULL, 0x1a784379d99db420ULL }, { 0x0000000000000000ULL, 0x108b2a2c28029094ULL },
+  { 0x0000000000000000ULL, 0x14adf4b7320334b9ULL }, { 0x4000000000000000ULL, 0x19d971e4fe8401e7ULL },
+  { 0x8800000000000000ULL, 0x1027e72f1f128130ULL }, { 0xaa00000000000000ULL, 0x1431e0fae6d7217cULL },
+  { 0xd480000000000000ULL, 0x193e5939a08ce9dbULL }, { 0xc9a0000000000000ULL, 0x1f8def8808b02452ULL },
+  { 0xbe04000000000000ULL, 0x13b8b5b5056e16b3ULL }, { 0xad85000000000000ULL, 0x18a6e32246c99c60ULL },
+  { 0xd8e6400000000000ULL, 0x1ed09bead87c0378ULL }, { 0x878fe80000000000ULL, 0x13426172c74d822bULL },
+  { 0x6973e20000000000ULL, 0x1812f9cf7920e2b6ULL }, { 0x03d0da8000000000ULL, 0x1e17b84357691b64ULL },
+  { 0x8262889000000000ULL, 0x12ced32a16a1b11eULL }, { 0x22fb2ab400000000ULL, 0x178287f49c4a1d66ULL },
+  { 0xabb9f56100000000ULL, 0x1d6329f1c35ca4bfULL }, { 0xcb54395ca0000000ULL, 0x125dfa371a19e6f7ULL },
+  { 0xbe2947b3c8000000ULL, 0x16f578c4e0a060b5ULL }, { 0x2db399a0ba000000ULL, 0x1cb2d6f618c878e3ULL },
+  { 0xfc90400474400000ULL, 0x11efc659cf7d4b8dULL }, { 0x7bb4500591500000ULL, 0x166bb7f0435c9e71ULL },
+  { 0xdaa16406f5a40000ULL, 0x1c06a5ec5433c60dULL }, { 0xa8a4de8459868000ULL, 0x118427b3b4a05bc8ULL },
+  { 0xd2ce16256fe82000ULL, 0x15e531a0a1c872baULL }, { 0x87819baecbe22800ULL, 0x1b5e7e08ca3a8f69ULL },
+  { 0xf4b1014d3f6d5900ULL, 0x111b0ec57e6499a1ULL }, { 0x71dd41a08f48af40ULL, 0x1561d276ddfdc00aULL },
+  { 0x0e549208b31adb10ULL, 0x1aba4714957d300dULL }, { 0x28f4db456ff0c8eaULL, 0x10b46c6cdd6e3e08ULL },
+  { 0x33321216cbecfb24ULL, 0x14e1878814c9cd8aULL }, { 0xbffe969c7ee839edULL, 0x1a19e96a19fc40ecULL },
+  { 0xf7ff1e21cf512434ULL, 0x105031e2503da893ULL }, { 0xf5fee5aa43256d41ULL, 0x14643e5ae44d12b8ULL },
+  { 0x337e9f14d3eec892ULL, 0x197d4df19d605767ULL }, { 0x005e46da08ea7ab6ULL, 0x1fdca16e04b86d41ULL },
+  { 0xa03aec4845928cb2ULL, 0x13e9e4e4c2f34448ULL }, { 0xc849a75a56f72fdeULL, 0x18e45e1df3b0155aULL },
+  { 0x7a5c1130ecb4fbd6ULL, 0x1f1d75a5709c1ab1ULL }, { 0xec798abe93f11d65ULL, 0x13726987666190aeULL },
+  { 0xa797ed6e38ed64bfULL, 0x184f03e93ff9f4daULL }, { 0x517de8c9c728bdefULL, 0x1e62c4e38ff87211ULL },
+  { 0xd2eeb17e1c7976b5ULL, 0x12fdbb0e39fb474aULL }, { 0x87aa5ddda397d462ULL, 0x17bd29d1c87a191dULL },
+  { 0xe994f5550c7dc97bULL, 0x1dac74463a989f64ULL }, { 0x11fd195527ce9dedULL, 0x128bc8abe49f639fULL },
+  { 0xd67c5faa71c24568ULL, 0x172ebad6ddc73c86ULL }, { 0x8c1b77950e32d6c2ULL, 0x1cfa698c95390ba8ULL },
+  { 0x57912abd28dfc639ULL, 0x121c81f7dd43a749ULL }, { 0xad75756c7317b7c8ULL, 0x16a3a275d494911bULL },
+  { 0x98d2d2c78fdda5baULL, 0x1c4c8b1349b9b562ULL }, { 0x9f83c3bcb9ea8794ULL, 0x11afd6ec0e14115dULL },
+  { 0x0764b4abe8652979ULL, 0x161bcca7119915b5ULL }, { 0x493de1d6e27e73d7ULL, 0x1ba2bfd0d5ff5b22ULL },
+  { 0x6dc6ad264d8f0866ULL, 0x1145b7e285bf98f5ULL }, { 0xc938586fe0f2ca80ULL, 0x159725db272f7f32ULL },
+  { 0x7b866e8bd92f7d20ULL, 0x1afcef51f0fb5effULL }, { 0xad34051767bdae34ULL, 0x10de1593369d1b5fULL },
+  { 0x9881065d41ad19c1ULL, 0x15159af804446237ULL }, { 0x7ea147f492186032ULL, 0x1a5b01b605557ac5ULL },
+  { 0x6f24ccf8db4f3c1fULL, 0x1078e111c3556cbbULL }, { 0x4aee003712230b27ULL, 0x14971956342ac7eaULL },
+  { 0xdda98044d6abcdf0ULL, 0x19bcdfabc13579e4ULL }, { 0x0a89f02b062b60b6ULL, 0x10160bcb58c16c2fULL },
+  { 0xcd2c6c35c7b638e4ULL, 0x141b8ebe2ef1c73aULL }, { 0x8077874339a3c71dULL, 0x1922726dbaae3909ULL },
+  { 0xe0956914080cb8e4ULL, 0x1f6b0f092959c74bULL }, { 0x6c5d61ac8507f38eULL, 0x13a2e965b9d81c8fULL },
+  { 0x4774ba17a649f072ULL, 0x188ba3bf284e23b3ULL }, { 0x1951e89d8fdc6c8fULL, 0x1eae8caef261aca0ULL },
+  { 0x0fd3316279e9c3d9ULL, 0x132d17ed577d0be4ULL }, { 0x13c7fdbb186434cfULL, 0x17f85de8ad5c4eddULL },
+  { 0x58b9fd29de7d4203ULL, 0x1df67562d8b36294ULL }, { 0xb7743e3a2b0e4942ULL, 0x12ba095dc7701d9cULL },
+  { 0xe5514dc8b5d1db92ULL, 0x17688bb5394c2503ULL }, { 0xdea5a13ae3465277ULL, 0x1d42aea2879f2e44ULL },
+  { 0x0b2784c4ce0bf38aULL, 0x1249ad2594c37cebULL }, { 0xcdf165f6018ef06dULL, 0x16dc186ef9f45c25ULL },
+  { 0x416dbf7381f2ac88ULL, 0x1c931e8ab871732fULL }, { 0x88e497a83137abd5ULL, 0x11dbf316b346e7fdULL },
+  { 0xeb1dbd923d8596caULL, 0x1652efdc6018a1fcULL }, { 0x25e52cf6cce6fc7dULL, 0x1be7abd3781eca7cULL },
+  { 0x97af3c1a40105dceULL, 0x1170cb642b133e8dULL }, { 0xfd9b0b20d0147542ULL, 0x15ccfe3d35d80e30ULL },
+  { 0x3d01cde904199292ULL, 0x1b403dcc834e11bdULL }, { 0x462120b1a28ffb9bULL, 0x1108269fd210cb16ULL },
+  { 0xd7a968de0b33fa82ULL, 0x154a3047c694fddbULL }, { 0xcd93c3158e00f923ULL, 0x1a9cbc59b83a3d52ULL },
+  { 0xc07c59ed78c09bb6ULL, 0x10a1f5b813246653ULL }, { 0xb09b7068d6f0c2a3ULL, 0x14ca732617ed7fe8ULL },
+  { 0xdcc24c830cacf34cULL, 0x19fd0fef9de8dfe2ULL }, { 0xc9f96fd1e7ec180fULL, 0x103e29f5c2b18bedULL },
+  { 0x3c77cbc661e71e13ULL, 0x144db473335deee9ULL }, { 0x8b95beb7fa60e598ULL, 0x1961219000356aa3ULL },
+  { 0x6e7b2e65f8f91efeULL, 0x1fb969f40042c54cULL }, { 0xc50cfcffbb9bb35fULL, 0x13d3e2388029bb4fULL },
+  { 0xb6503c3faa82a037ULL, 0x18c8dac6a0342a23ULL }, { 0xa3e44b4f95234844ULL, 0x1efb1178484134acULL },
+  { 0xe66eaf11bd360d2bULL, 0x135ceaeb2d28c0ebULL }, { 0xe00a5ad62c839075ULL, 0x183425a5f872f126ULL },
+  { 0x980cf18bb7a47493ULL, 0x1e412f0f768fad70ULL }, { 0x5f0816f752c6c8dcULL, 0x12e8bd69aa19cc66ULL },
+  { 0xf6ca1cb527787b13ULL, 0x17a2ecc414a03f7fULL }, { 0xf47ca3e2715699d7ULL, 0x1d8ba7f519c84f5fULL },
+  { 0xf8cde66d86d62026ULL, 0x127748f9301d319bULL }, { 0xf7016008e88ba830ULL, 0x17151b377c247e02ULL },
+  { 0xb4c1b80b22ae923cULL, 0x1cda62055b2d9d83ULL }, { 0x50f91306f5ad1b65ULL, 0x12087d4358fc8272ULL },
+  { 0xe53757c8b318623fULL, 0x168a9c942f3ba30eULL }, { 0x9e852dbadfde7acfULL, 0x1c2d43b93b0a8bd2ULL },
+  { 0xa3133c94cbeb0cc1ULL, 0x119c4a53c4e69763ULL }, { 0x8bd80bb9fee5cff1ULL, 0x16035ce8b6203d3cULL },
+  { 0xaece0ea87e9f43eeULL, 0x1b843422e3a84c8bULL }, { 0x4d40c9294f238a75ULL, 0x1132a095ce492fd7ULL },
+  { 0x2090fb73a2ec6d12ULL, 0x157f48bb41db7bcdULL }, { 0x68b53a508ba78856ULL, 0x1adf1aea12525ac0ULL },
+  { 0x417144725748b536ULL, 0x10cb70d24b7378b8ULL }, { 0x51cd958eed1ae283ULL, 0x14fe4d06de5056e6ULL },
+  { 0xe640faf2a8619b24ULL, 0x1a3de04895e46c9fULL }, { 0xefe89cd7a93d00f7ULL, 0x1066ac2d5daec3e3ULL },
+  { 0xebe2c40d938c4134ULL, 0x14805738b51a74dcULL }, { 0x26db7510f86f5181ULL, 0x19a06d06e2611214ULL },
+  { 0x9849292a9b4592f1ULL, 0x100444244d7cab4cULL }, { 0xbe5b73754216f7adULL, 0x1405552d60dbd61fULL },
+  { 0xadf25052929cb598ULL, 0x1906aa78b912cba7ULL }, { 0x996ee4673743e2ffULL, 0x1f485516e7577e91ULL },
+  { 0xffe54ec0828a6ddfULL, 0x138d352e5096af1aULL }, { 0xbfdea270a32d0957ULL, 0x18708279e4bc5ae1ULL },
+  { 0x2fd64b0ccbf84badULL, 0x1e8ca3185deb719aULL }, { 0x5de5eee7ff7b2f4cULL, 0x1317e5ef3ab32700ULL },
+  { 0x755f6aa1ff59fb1fULL, 0x17dddf6b095ff0c0ULL }, { 0x92b7454a7f3079e7ULL, 0x1dd55745cbb7ecf0ULL },
+  { 0x5bb28b4e8f7e4c30ULL, 0x12a5568b9f52f416ULL }, { 0xf29f2e22335ddf3cULL, 0x174eac2e8727b11bULL },
+  { 0xef46f9aac035570bULL, 0x1d22573a28f19d62ULL }, { 0xd58c5c0ab8215667ULL, 0x123576845997025dULL },
+  { 0x4aef730d6629ac01ULL, 0x16c2d4256ffcc2f5ULL }, { 0x9dab4fd0bfb41701ULL, 0x1c73892ecbfbf3b2ULL },
+  { 0xa28b11e277d08e60ULL, 0x11c835bd3f7d784fULL }, { 0x8b2dd65b15c4b1f9ULL, 0x163a432c8f5cd663ULL },
+  { 0x6df94bf1db35de77ULL, 0x1bc8d3f7b3340bfcULL }, { 0xc4bbcf772901ab0aULL, 0x115d847ad000877dULL },
+  { 0x35eac354f34215cdULL, 0x15b4e5998400a95dULL }, { 0x8365742a30129b40ULL, 0x1b221effe500d3b4ULL },
+  { 0xd21f689a5e0ba108ULL, 0x10f5535fef208450ULL }, { 0x06a742c0f58e894aULL, 0x1532a837eae8a565ULL },
+  { 0x4851137132f22b9dULL, 0x1a7f5245e5a2cebeULL }, { 0xed32ac26bfd75b42ULL, 0x108f936baf85c136ULL },
+  { 0xa87f57306fcd3212ULL, 0x14b378469b673184ULL }, { 0xd29f2cfc8bc07e97ULL, 0x19e056584240fde5ULL },
+  { 0xa3a37c1dd7584f1eULL, 0x102c35f729689eafULL }, { 0x8c8c5b254d2e62e6ULL, 0x14374374f3c2c65bULL },
+  { 0x6faf71eea079fb9fULL, 0x1945145230b377f2ULL }, { 0x0b9b4e6a48987a87ULL, 0x1f965966bce055efULL },
+  { 0x674111026d5f4c94ULL, 0x13bdf7e0360c35b5ULL }, { 0xc111554308b71fbaULL, 0x18ad75d8438f4322ULL },
+  { 0x7155aa93cae4e7a8ULL, 0x1ed8d34e547313ebULL }, { 0x26d58a9c5ecf10c9ULL, 0x13478410f4c7ec73ULL },
+  { 0xf08aed437682d4fbULL, 0x1819651531f9e78fULL }, { 0xecada89454238a3aULL, 0x1e1fbe5a7e786173ULL },
+  { 0x73ec895cb4963664ULL, 0x12d3d6f88f0b3ce8ULL }, { 0x90e7abb3e1bbc3fdULL, 0x1788ccb6b2ce0c22ULL },
+  { 0x352196a0da2ab4fdULL, 0x1d6affe45f818f2bULL }, { 0x0134fe24885ab11eULL, 0x1262dfeebbb0f97bULL },
+  { 0xc1823dadaa715d65ULL, 0x16fb97ea6a9d37d9ULL }, { 0x31e2cd19150db4bfULL, 0x1cba7de5054485d0ULL },
+  { 0x1f2dc02fad2890f7ULL, 0x11f48eaf234ad3a2ULL }, { 0xa6f9303b9872b535ULL, 0x1671b25aec1d888aULL },
+  { 0x50b77c4a7e8f6282ULL, 0x1c0e1ef1a724eaadULL }, { 0x5272adae8f199d91ULL, 0x1188d357087712acULL },
+  { 0x670f591a32e004f6ULL, 0x15eb082cca94d757ULL }, { 0x40d32f60bf980633ULL, 0x1b65ca37fd3a0d2dULL },
+  { 0x4883fd9c77bf03e0ULL, 0x111f9e62fe44483cULL }, { 0x5aa4fd0395aec4d8ULL, 0x156785fbbdd55a4bULL },
+  { 0x314e3c447b1a760eULL, 0x1ac1677aad4ab0deULL }, { 0xded0e5aaccf089c9ULL, 0x10b8e0acac4eae8aULL },
+  { 0x96851f15802cac3bULL, 0x14e718d7d7625a2dULL }, { 0xfc2666dae037d74aULL, 0x1a20df0dcd3af0b8ULL },
+  { 0x9d980048cc22e68eULL, 0x10548b68a044d673ULL }, { 0x84fe005aff2ba032ULL, 0x1469ae42c8560c10ULL },
+  { 0xa63d8071bef6883eULL, 0x198419d37a6b8f14ULL }, { 0xcfcce08e2eb42a4eULL, 0x1fe52048590672d9ULL },
+  { 0x21e00c58dd309a70ULL, 0x13ef342d37a407c8ULL }, { 0x2a580f6f147cc10dULL, 0x18eb0138858d09baULL },
+  { 0xb4ee134ad99bf150ULL, 0x1f25c186a6f04c28ULL }, { 0x7114cc0ec80176d2ULL, 0x137798f428562f99ULL },
+  { 0xcd59ff127a01d486ULL, 0x18557f31326bbb7fULL }, { 0xc0b07ed7188249a8ULL, 0x1e6adefd7f06aa5fULL },
+  { 0xd86e4f466f516e09ULL, 0x1302cb5e6f642a7bULL }, { 0xce89e3180b25c98bULL, 0x17c37e360b3d351aULL },
+  { 0x822c5bde0def3beeULL, 0x1db45dc38e0c8261ULL }, { 0xf15bb96ac8b58575ULL, 0x1290ba9a38c7d17cULL },
+  { 0x2db2a7c57ae2e6d2ULL, 0x1734e940c6f9c5dcULL }, { 0x391f51b6d99ba086ULL, 0x1d022390f8b83753ULL },
+  { 0x03b3931248014454ULL, 0x1221563a9b732294ULL }, { 0x04a077d6da019569ULL, 0x16a9abc9424feb39ULL },
+  { 0x45c895cc9081fac3ULL, 0x1c5416bb92e3e607ULL }, { 0x8b9d5d9fda513cbaULL, 0x11b48e353bce6fc4ULL },
+  { 0xae84b507d0e58be8ULL, 0x1621b1c28ac20bb5ULL }, { 0x1a25e249c51eeee3ULL, 0x1baa1e332d728ea3ULL },
+  { 0xf057ad6e1b33554dULL, 0x114a52dffc679925ULL }, { 0x6c6d98c9a2002aa1ULL, 0x159ce797fb817f6fULL },
+  { 0x4788fefc0a803549ULL, 0x1b04217dfa61df4bULL }, { 0x0cb59f5d8690214eULL, 0x10e294eebc7d2b8fULL },
+  { 0xcfe30734e83429a1ULL, 0x151b3a2a6b9c7672ULL }, { 0x83dbc9022241340aULL, 0x1a6208b50683940fULL },
+  { 0xb2695da15568c086ULL, 0x107d457124123c89ULL }, { 0x1f03b509aac2f0a7ULL, 0x149c96cd6d16cbacULL },
+  { 0x26c4a24c1573acd1ULL, 0x19c3bc80c85c7e97ULL }, { 0x783ae56f8d684c03ULL, 0x101a55d07d39cf1eULL },
+  { 0x16499ecb70c25f03ULL, 0x1420eb449c8842e6ULL }, { 0x9bdc067e4cf2f6c4ULL, 0x19292615c3aa539fULL },
+  { 0x82d3081de02fb476ULL, 0x1f736f9b3494e887ULL }, { 0xb1c3e512ac1dd0c9ULL, 0x13a825c100dd1154ULL },
+  { 0xde34de57572544fcULL, 0x18922f31411455a9ULL }, { 0x55c215ed2cee963bULL, 0x1eb6bafd91596b14ULL },
+  { 0xb5994db43c151de5ULL, 0x133234de7ad7e2ecULL }, { 0xe2ffa1214b1a655eULL, 0x17fec216198ddba7ULL },
+  { 0xdbbf89699de0feb6ULL, 0x1dfe729b9ff15291ULL }, { 0x2957b5e202ac9f31ULL, 0x12bf07a143f6d39bULL },
+  { 0xf3ada35a8357c6feULL, 0x176ec98994f48881ULL }, { 0x70990c31242db8bdULL, 0x1d4a7bebfa31aaa2ULL },
+  { 0x865fa79eb69c9376ULL, 0x124e8d737c5f0aa5ULL }, { 0xe7f791866443b854ULL, 0x16e230d05b76cd4eULL },
+  { 0xa1f575e7fd54a669ULL, 0x1c9abd04725480a2ULL }, { 0xa53969b0fe54e801ULL, 0x11e0b622c774d065ULL },
+  { 0x0e87c41d3dea2202ULL, 0x1658e3ab7952047fULL }, { 0xd229b5248d64aa82ULL, 0x1bef1c9657a6859eULL },
+  { 0x435a1136d85eea91ULL, 0x117571ddf6c81383ULL }, { 0x143095848e76a536ULL, 0x15d2ce55747a1864ULL },
+  { 0x193cbae5b2144e83ULL, 0x1b4781ead1989e7dULL }, { 0x2fc5f4cf8f4cb112ULL, 0x110cb132c2ff630eULL },
+  { 0xbbb77203731fdd56ULL, 0x154fdd7f73bf3bd1ULL }, { 0x2aa54e844fe7d4acULL, 0x1aa3d4df50af0ac6ULL },
+  { 0xdaa75112b1f0e4ebULL, 0x10a6650b926d66bbULL }, { 0xd15125575e6d1e26ULL, 0x14cffe4e7708c06aULL },
+  { 0x85a56ead360865b0ULL, 0x1a03fde214caf085ULL }, { 0x7387652c41c53f8eULL, 0x10427ead4cfed653ULL },
+  { 0x50693e7752368f71ULL, 0x14531e58a03e8be8ULL }, { 0x64838e1526c4334eULL, 0x1967e5eec84e2ee2ULL },
+  { 0xfda4719a70754022ULL, 0x1fc1df6a7a61ba9aULL }, { 0xde86c70086494815ULL, 0x13d92ba28c7d14a0ULL },
+  { 0x162878c0a7db9a1aULL, 0x18cf768b2f9c59c9ULL }, { 0x5bb296f0d1d280a1ULL, 0x1f03542dfb83703bULL },
+  { 0x194f9e5683239064ULL, 0x1362149cbd322625ULL }, { 0x5fa385ec23ec747eULL, 0x183a99c3ec7eafaeULL },
+  { 0xf78c67672ce7919dULL, 0x1e494034e79e5b99ULL }, { 0x3ab7c0a07c10bb02ULL, 0x12edc82110c2f940ULL },
+  { 0x4965b0c89b14e9c3ULL, 0x17a93a2954f3b790ULL }, { 0x5bbf1cfac1da2433ULL, 0x1d9388b3aa30a574ULL },
+  { 0xb957721cb92856a0ULL, 0x127c35704a5e6768ULL }, { 0xe7ad4ea3e7726c48ULL, 0x171b42cc5cf60142ULL },
+  { 0xa198a24ce14f075aULL, 0x1ce2137f74338193ULL }, { 0x44ff65700cd16498ULL, 0x120d4c2fa8a030fcULL },
+  { 0x563f3ecc1005bdbeULL, 0x16909f3b92c83d3bULL }, { 0x2bcf0e7f14072d2eULL, 0x1c34c70a777a4c8aULL },
+  { 0x5b61690f6c847c3dULL, 0x11a0fc668aac6fd6ULL }, { 0xf239c35347a59b4cULL, 0x16093b802d578bcbULL },
+  { 0xeec83428198f021fULL, 0x1b8b8a6038ad6ebeULL }, { 0x553d20990ff96153ULL, 0x1137367c236c6537ULL },
+  { 0x2a8c68bf53f7b9a8ULL, 0x1585041b2c477e85ULL }, { 0x752f82ef28f5a812ULL, 0x1ae64521f7595e26ULL },
+  { 0x093db1d57999890bULL, 0x10cfeb353a97dad8ULL }, { 0x0b8d1e4ad7ffeb4eULL, 0x1503e602893dd18eULL },
+  { 0x8e7065dd8dffe622ULL, 0x1a44df832b8d45f1ULL }, { 0xf9063faa78bfefd5ULL, 0x106b0bb1fb384bb6ULL },
+  { 0xb747cf9516efebcaULL, 0x1485ce9e7a065ea4ULL }, { 0xe519c37a5cabe6bdULL, 0x19a742461887f64dULL },
+  { 0xaf301a2c79eb7036ULL, 0x1008896bcf54f9f0ULL }, { 0xdafc20b798664c43ULL, 0x140aabc6c32a386cULL },
+  { 0x11bb28e57e7fdf54ULL, 0x190d56b873f4c688ULL }, { 0x1629f31ede1fd72aULL, 0x1f50ac6690f1f82aULL },
+  { 0x4dda37f34ad3e67aULL, 0x13926bc01a973b1aULL }, { 0xe150c5f01d88e019ULL, 0x187706b0213d09e0ULL },
+  { 0x19a4f76c24eb181fULL, 0x1e94c85c298c4c59ULL }, { 0xb0071aa39712ef13ULL, 0x131cfd3999f7afb7ULL },
+  { 0x9c08e14c7cd7aad8ULL, 0x17e43c8800759ba5ULL }, { 0x030b199f9c0d958eULL, 0x1ddd4baa0093028fULL },
+  { 0x61e6f003c1887d79ULL, 0x12aa4f4a405be199ULL }, { 0xba60ac04b1ea9cd7ULL, 0x1754e31cd072d9ffULL },
+  { 0xa8f8d705de65440dULL, 0x1d2a1be4048f907fULL }, { 0xc99b8663aaff4a88ULL, 0x123a516e82d9ba4fULL },
+  { 0xbc0267fc95bf1d2aULL, 0x16c8e5ca239028e3ULL }, { 0xab0301fbbb2ee474ULL, 0x1c7b1f3cac74331cULL },
+  { 0xeae1e13d54fd4ec9ULL, 0x11ccf385ebc89ff1ULL }, { 0x659a598caa3ca27bULL, 0x1640306766bac7eeULL },
+  { 0xff00efefd4cbcb1aULL, 0x1bd03c81406979e9ULL }, { 0x3f6095f5e4ff5ef0ULL, 0x116225d0c841ec32ULL },
+  { 0xcf38bb735e3f36acULL, 0x15baaf44fa52673eULL }, { 0x8306ea5035cf0457ULL, 0x1b295b1638e7010eULL },
+  { 0x11e4527221a162b6ULL, 0x10f9d8ede39060a9ULL }, { 0x565d670eaa09bb64ULL, 0x15384f295c7478d3ULL },
+  { 0x2bf4c0d2548c2a3dULL, 0x1a8662f3b3919708ULL }, { 0x1b78f88374d79a66ULL, 0x1093fdd8503afe65ULL },
+  { 0x625736a4520d8100ULL, 0x14b8fd4e6449bdfeULL }, { 0xfaed044d6690e140ULL, 0x19e73ca1fd5c2d7dULL },
+  { 0xbcd422b0601a8cc8ULL, 0x103085e53e599c6eULL }, { 0x6c092b5c78212ffaULL, 0x143ca75e8df0038aULL },
+  { 0x070b763396297bf8ULL, 0x194bd136316c046dULL }, { 0x48ce53c07bb3daf6ULL, 0x1f9ec583bdc70588ULL },
+  { 0x2d80f4584d5068daULL, 0x13c33b72569c6375ULL }, { 0x78e1316e60a48310ULL, 0x18b40a4eec437c52ULL }
+};
+
+
+// internal (m * mul) >> shift of a 64-bit value and a 128-bit multiplier (low, high), 'shift' is in (64, 128)
+static inline uint64_t _rtoa_mul_shift64(uint64_t m, const uint64_t* mul, unsigned int shift)
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_type;
+  const uint128_type lo = (uint128_type)m * mul[0];
+  const uint128_type hi = (uint128_type)m * mul[1];
+  return (uint64_t)(((lo >> 64U) + hi) >> (shift - 64U));
+#else
+  // 64x64 bit products from 32 bit halves
+  uint64_t prod[2][2];
+  for (size_t k = 0U; k < 2U; ++k) {
+    const uint64_t a0 = (uint32_t)m, a1 = m >> 32U, b0 = (uint32_t)mul[k], b1 = mul[k] >> 32U;
+    const uint64_t mid1 = a1 * b0 + ((a0 * b0) >> 32U);
+    const uint64_t mid2 = a0 * b1 + (uint32_t)mid1;
+    prod[k][1] = a1 * b1 + (mid1 >> 32U) + (mid2 >> 32U);
+    prod[k][0] = (mid2 << 32U) | (uint32_t)(a0 * b0);
+  }
+  const uint64_t sum_lo = prod[0][1] + prod[1][0];
+  const uint64_t sum_hi = prod[1][1] + ((sum_lo < prod[0][1]) ? 1U : 0U);
+  shift -= 64U;
+  return (sum_hi << (64U - shift)) | (sum_lo >> shift);
+#endif
+}
+
+
+// internal shortest decimal of a finite, positive double in its IEEE-754 bits, value = digits * 10^exp10
+static uint64_t _rtoa_shortest64(uint64_t bits, int* exp10)
+{
+  const uint64_t ieee_mant = bits & ((1ULL << 52U) - 1U);
+  const unsigned int ieee_exp = (unsigned int)(bits >> 52U);
+  const int      e2  = (ieee_exp ? (int)ieee_exp : 1) - 1023 - 52 - 2;
+  const uint64_t m2  = ieee_exp ? (1ULL << 52U) | ieee_mant : ieee_mant;
+  const bool     accept_bounds = !(m2 & 1U);
+
+  // the interval [mm, mp] of values rounding to m2, all times 4
+  const uint64_t mv = 4U * m2;
+  const uint64_t mp = 4U * m2 + 2U;
+  const uint64_t mm = 4U * m2 - 1U - ((ieee_mant || (ieee_exp <= 1U)) ? 1U : 0U);
+
+  uint64_t vr, vp, vm;
+  int e10;
+  bool vm_trailing_zeros = false, vr_trailing_zeros = false;
+  if (e2 >= 0) {
+    // one digit less than the exponent allows, so the loop below removes at least one digit
+    const unsigned int q = _rtoa_log10_pow2((unsigned int)e2) - ((e2 > 3) ? 1U : 0U);
+    const unsigned int i = q + 125U + _rtoa_pow5bits(q) - 1U - (unsigned int)e2;
+    e10 = (int)q;
+    vr = _rtoa_mul_shift64(mv, _rtoa_pow5_inv[q], i);
+    vp = _rtoa_mul_shift64(mp, _rtoa_pow5_inv[q], i);
+    vm = _rtoa_mul_shift64(mm, _rtoa_pow5_inv[q], i);
+    if (q <= 21U) {
+      // only one of mp, mv and mm can be a multiple of 5
+      if (!(mv % 5U)) {
+        vr_trailing_zeros = _rtoa_pow5_factor(mv) >= q;
+      }
+      else if (accept_bounds) {
+        vm_trailing_zeros = _rtoa_pow5_factor(mm) >= q;
+      }
+      else {
+        vp -= (_rtoa_pow5_factor(mp) >= q) ? 1U : 0U;
+      }
+    }
+  }
+  else {
+    const unsigned int q = _rtoa_log10_pow5((unsigned int)-e2) - ((-e2 > 1) ? 1U : 0U);
+    const unsigned int i = (unsigned int)-e2 - q;
+    const unsigned int j = q + 125U - _rtoa_pow5bits(i);
+    e10 = (int)q + e2;
+    vr = _rtoa_mul_shift64(mv, _rtoa_pow5[i], j);
+    vp = _rtoa_mul_shift64(mp, _rtoa_pow5[i], j);
+    vm = _rtoa_mul_shift64(mm, _rtoa_pow5[i], j);
+    if (q <= 1U) {
+      // mv = 4 * m2 has at least 2 trailing zero bits
+      vr_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_trailing_zeros = mm == mv - 2U;
+      }
+      else {
+        --vp;
+      }
+    }
+    else if (q < 63U) {
+      vr_trailing_zeros = !(mv & ((1ULL << q) - 1U));
+    }
+  }
+
+  // remove the digits while the interval still holds a shorter decimal
+  int removed = 0;
+  unsigned int last_removed = 0U;
+  if (vm_trailing_zeros || vr_trailing_zeros) {
+    // rare, the interval bounds or the value may be exact
+    while (vp / 10U > vm / 10U) {
+      vm_trailing_zeros &= !(vm % 10U);
+      vr_trailing_zeros &= !last_removed;
+      last_removed = (unsigned int)(vr % 10U);
+      vr /= 10U; vp /= 10U; vm /= 10U;
+      ++removed;
+    }
+    if (vm_trailing_zeros) {
+      while (!(vm % 10U)) {
+        vr_trailing_zeros &= !last_removed;
+        last_removed = (unsigned int)(vr % 10U);
+        vr /= 10U; vp /= 10U; vm /= 10U;
+        ++removed;
+      }
+    }
+    if (vr_trailing_zeros && (last_removed == 5U) && !(vr & 1U)) {
+      // exactly halfway, round to even
+      last_removed = 4U;
+    }
+    *exp10 = e10 + removed;
+    return vr + ((((vr == vm) && (!accept_bounds || !vm_trailing_zeros)) || (last_removed >= 5U)) ? 1U : 0U);
+  }
+  // common case, two digits per step first
+  while (vp / 100U > vm / 100U) {
+    last_removed = (unsigned int)(vr % 100U) / 10U;
+    vr /= 100U; vp /= 100U; vm /= 100U;
+    removed += 2;
+  }
+  while (vp / 10U > vm / 10U) {
+    last_removed = (unsigned int)(vr % 10U);
+    vr /= 10U; vp /= 10U; vm /= 10U;
+    ++removed;
+  }
+  *exp10 = e10 + removed;
+  return vr + (((vr == vm) || (last_removed >= 5U)) ? 1U : 0U);
+}
+#endif  // PRINTF_SUPPORT_ROUNDTRIP_DOUBLE
+
+
+// internal shortest round-trip notation, the digits in fixed notation for decimal exponents from -4 to
+// the number of significant digits (9 for float, 17 for double), exponential notation otherwise
+// the 'h' length modifier (FLAGS_SHORT) selects the shortest notation which round-trips as float
+PRINTF_ENGINE_SHARED static size_t _rtoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int width, unsigned int flags)
+{
+  // longest is "0.0000" or 'e' notation with 17 digits
+  char buf[32];
+  const size_t start = idx;
+
+  union {
+    uint64_t U;
+    double   F;
+  } conv;
+  conv.F = value;
+
+  // check for NaN and special values, -0.0 is printed without sign
+  const bool negative = (conv.U >> 63U) && (conv.U << 1U);
+  if (((conv.U >> 52U) & 0x7FFU) == 0x7FFU) {
+    return _ftoa_special(out, buffer, idx, maxlen, (conv.U << 12U) != 0U, negative, width, flags);
+  }
+
+  uint64_t digits = 0U;
+  int exp10 = 0;
+  unsigned int max_digits = 17U;
+#if defined(PRINTF_SUPPORT_ROUNDTRIP_DOUBLE)
+  if (!(flags & FLAGS_SHORT)) {
+    const uint64_t bits = conv.U & ~(1ULL << 63U);
+    if (bits) {
+      digits = _rtoa_shortest64(bits, &exp10);
+    }
+  }
+  else
+#endif
+  {
+    const uint32_t bits = _ftoa_float_bits(value) & ~(1U << 31U);
+    if (bits == 0x7F800000U) {
+      // out of the float range
+      return _ftoa_special(out, buffer, idx, maxlen, false, negative, width, flags);
+    }
+    if (bits) {
+      digits = _rtoa_shortest32(bits, &exp10);
+    }
+    max_digits = 9U;
+  }
+
+  // the digits, and the decimal exponent of the first one
+  const size_t count = _ntoa_count(digits, 10U);
+  const int    exp   = exp10 + (int)count - 1;
+
+  size_t len;
+  if ((exp >= -4) && (exp < (int)max_digits)) {
+    if (exp < 0) {
+      // "0.000ddd"
+      buf[0] = '0';
+      buf[1] = '.';
+      len = 2U;
+      for (int i = exp; ++i < 0; ) {
+        buf[len++] = '0';
+      }
+      len += count;
+      _dec_long_long(buf + len, digits, count);
+    }
+    else if (count <= (size_t)exp + 1U) {
+      // "ddd000"
+      _dec_long_long(buf + count, digits, count);
+      for (len = count; len <= (size_t)exp; ++len) {
+        buf[len] = '0';
+      }
+    }
+    else {
+      // "ddd.ddd", the integer digits are moved in front of the point
+      _dec_long_long(buf + 1U + count, digits, count);
+      for (size_t i = 0U; i <= (size_t)exp; ++i) {
+        buf[i] = buf[i + 1U];
+      }
+      buf[exp + 1] = '.';
+      len = count + 1U;
+    }
+  }
+  else {
+    // "d.ddde+XX"
+    const unsigned int e = (unsigned int)(exp < 0 ? -exp : exp);
+    _dec_long_long(buf + count, digits, count);
+    len = count;
+    if (count > 1U) {
+      // the fraction digits are moved behind the point
+      for (; len > 1U; --len) {
+        buf[len] = buf[len - 1U];
+      }
+      buf[1] = '.';
+      len = count + 1U;
+    }
+    buf[len++] = (flags & FLAGS_UPPERCASE) ? 'E' : 'e';
+    buf[len++] = exp < 0 ? '-' : '+';
+    if (e >= 100U) {
+      buf[len++] = (char)('0' + e / 100U);
+    }
+    buf[len++] = (char)('0' + e / 10U % 10U);
+    buf[len++] = (char)('0' + e % 10U);
+  }
+
+  // pad leading zeros
+  size_t zeros = 0U;
+  if (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
+    if (width && (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE)))) {
+      width--;
+    }
+    if (len < width) {
+      zeros = width - len;
+    }
+  }
+
+  const char* sign = negative ? "-" : (flags & FLAGS_PLUS) ? "+" : (flags & FLAGS_SPACE) ? " " : "";
+  idx = _out_number_head(out, buffer, idx, maxlen, sign, *sign ? 1U : 0U, zeros, len, width, flags);
+  out(buf, len, buffer, idx, maxlen);
+  return _out_number_tail(out, buffer, start, idx + len, maxlen, width, flags);
+}
+#endif  // PRINTF_SUPPORT_ROUNDTRIP
+#endif  // PRINTF_SUPPORT_FLOAT
+
+
+// internal argument source, a va_list, an argument array or the arguments of a binary record
+typedef struct {
+  va_list                va;
+  const printf_arg_type* array;     // argument array, NULL when not used
+  const printf_arg_type* array_end;
+#if defined(PRINTF_SUPPORT_BINARY)
+  const unsigned char*   data;      // binary record arguments, NULL when not used
+  const unsigned char*   end;
+#endif
+} arg_type;
+
+
+// internal placeholder for missing array arguments
+static const printf_arg_type _arg_none = { PRINTF_ARG_NONE, { 0 } };
+
+
+// internal read of the next array argument as integer
+// other argument types are converted, so a mismatch with the specifier has a defined result
+static unsigned long long _arg_array_integer(arg_type* args)
+{
+  const printf_arg_type* arg = (args->array < args->array_end) ? args->array++ : &_arg_none;
+  switch (arg->tag) {
+    case PRINTF_ARG_INT :
+      return (unsigned long long)arg->value.i;
+    case PRINTF_ARG_UINT :
+      return arg->value.u;
+    case PRINTF_ARG_DOUBLE :
+      // out of range values read as 0
+      return ((arg->value.d > -9.2e18) && (arg->value.d < 9.2e18)) ? (unsigned long long)(long long)arg->value.d : 0U;
+    case PRINTF_ARG_POINTER :
+      return (uintptr_t)arg->value.p;
+    default :
+      return 0U;
+  }
+}
+
+
+#if defined(PRINTF_SUPPORT_FLOAT)
+// internal read of the next array argument as double
+static double _arg_array_double(arg_type* args)
+{
+  const printf_arg_type* arg = (args->array < args->array_end) ? args->array++ : &_arg_none;
+  switch (arg->tag) {
+    case PRINTF_ARG_INT :
+      return (double)arg->value.i;
+    case PRINTF_ARG_UINT :
+      return (double)arg->value.u;
+    case PRINTF_ARG_DOUBLE :
+      return arg->value.d;
+    default :
+      return 0.0;
+  }
+}
+#endif
+
+
+// internal read of the next array argument as string
+static const char* _arg_array_string(arg_type* args)
+{
+  const printf_arg_type* arg = (args->array < args->array_end) ? args->array++ : &_arg_none;
+  if (arg->tag != PRINTF_ARG_STRING) {
+    return "";
+  }
+  return arg->value.s ? arg->value.s : "(null)";
+}
+
+
+// internal length flags the next array integer argument needs, so values wider than int aren't truncated
+// \return FLAGS_LONG or FLAGS_LONG_LONG if the value doesn't fit into an int, 0 otherwise
+static unsigned int _arg_array_length(const arg_type* args)
+{
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+  const unsigned int wide = FLAGS_LONG_LONG;
+#else
+  const unsigned int wide = FLAGS_LONG;   // truncated to long
+#endif
+  if (args->array >= args->array_end) {
+    return 0U;
+  }
+  const printf_arg_type* arg = args->array;
+  if (arg->tag == PRINTF_ARG_INT) {
+    if ((long long)(int)arg->value.i == arg->value.i) {
+      return 0U;
+    }
+    return ((long long)(long)arg->value.i == arg->value.i) ? FLAGS_LONG : wide;
+  }
+  if (arg->tag == PRINTF_ARG_UINT) {
+    if ((unsigned long long)(unsigned int)arg->value.u == arg->value.u) {
+      return 0U;
+    }
+    return ((unsigned long long)(unsigned long)arg->value.u == arg->value.u) ? FLAGS_LONG : wide;
+  }
+  return 0U;
+}
+
+
+#if defined(PRINTF_SUPPORT_BINARY)
+// internal read of an LEB128 encoded value from the binary record arguments
+static unsigned long long _bin_read(arg_type* args)
+{
+  unsigned long long value = 0U;
+  unsigned int shift = 0U;
+  while (args->data < args->end) {
+    const unsigned char byte = *args->data++;
+    if (shift < 64U) {
+      value |= (unsigned long long)(byte & 0x7FU) << shift;
+    }
+    shift += 7U;
+    if (!(byte & 0x80U)) {
+      break;
+    }
+  }
+  return value;
+}
+
+
+// internal read of a zigzag LEB128 encoded value from the binary record arguments
+static long long _bin_read_signed(arg_type* args)
+{
+  const unsigned long long value = _bin_read(args);
+  return (long long)((value >> 1U) ^ (0U - (value & 1U)));
+}
+#endif  // PRINTF_SUPPORT_BINARY
+
+
+// internal argument fetch functions
+static inline int _arg_int(arg_type* args)
+{
+  if (args->array) {
+    return (int)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return (int)_bin_read_signed(args);
+  }
+#endif
+  return va_arg(args->va, int);
+}
+
+
+static inline unsigned int _arg_uint(arg_type* args)
+{
+  if (args->array) {
+    return (unsigned int)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return (unsigned int)_bin_read(args);
+  }
+#endif
+  return va_arg(args->va, unsigned int);
+}
+
+
+static inline long _arg_long(arg_type* args)
+{
+  if (args->array) {
+    return (long)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return (long)_bin_read_signed(args);
+  }
+#endif
+  return va_arg(args->va, long);
+}
+
+
+static inline unsigned long _arg_ulong(arg_type* args)
+{
+  if (args->array) {
+    return (unsigned long)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return (unsigned long)_bin_read(args);
+  }
+#endif
+  return va_arg(args->va, unsigned long);
+}
+
+
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+static inline long long _arg_long_long(arg_type* args)
+{
+  if (args->array) {
+    return (long long)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return _bin_read_signed(args);
+  }
+#endif
+  return va_arg(args->va, long long);
+}
+
+
+static inline unsigned long long _arg_ulong_long(arg_type* args)
+{
+  if (args->array) {
+    return _arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return _bin_read(args);
+  }
+#endif
+  return va_arg(args->va, unsigned long long);
+}
+#endif  // PRINTF_SUPPORT_LONG_LONG
+
+
+#if defined(PRINTF_SUPPORT_FLOAT)
+static inline double _arg_double(arg_type* args)
+{
+  if (args->array) {
+    return _arg_array_double(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    // IEEE-754 bits, little endian
+    union {
+      uint64_t U;
+      double   F;
+    } conv;
+    conv.U = 0U;
+    for (unsigned int i = 0U; (i < 8U) && (args->data < args->end); ++i) {
+      conv.U |= (uint64_t)*args->data++ << (8U * i);
+    }
+    return conv.F;
+  }
+#endif
+  return va_arg(args->va, double);
+}
+#endif  // PRINTF_SUPPORT_FLOAT
+
+
+static inline const char* _arg_string(arg_type* args)
+{
+  if (args->array) {
+    return _arg_array_string(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    // the string is stored inline, including its terminating NUL
+    const unsigned char* s = args->data;
+    while ((s < args->end) && *s) {
+      s++;
+    }
+    if (s == args->end) {
+      // truncated record
+      args->data = args->end;
+      return "";
+    }
+    const char* str = (const char*)args->data;
+    args->data = s + 1;
+    return str;
+  }
+#endif
+  return va_arg(args->va, char*);
+}
+
+
+// internal hex digit count of a pointer, binary records carry the pointer size of the target they were encoded on
+static inline unsigned int _arg_pointer_width(arg_type* args)
+{
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (!args->array && args->data) {
+    return 2U * (unsigned int)_bin_read(args);
+  }
+#endif
+  (void)args;
+  return sizeof(void*) * 2U;
+}
+
+
+static inline uintptr_t _arg_pointer(arg_type* args)
+{
+  if (args->array) {
+    // strings read as 0 for numeric specifiers, but %p prints their address like printf() does
+    if ((args->array < args->array_end) && (args->array->tag == PRINTF_ARG_STRING)) {
+      return (uintptr_t)(args->array++)->value.s;
+    }
+    return (uintptr_t)_arg_array_integer(args);
+  }
+#if defined(PRINTF_SUPPORT_BINARY)
+  if (args->data) {
+    return (uintptr_t)_bin_read(args);
+  }
+#endif
+  return (uintptr_t)va_arg(args->va, void*);
+}
+
+
+// internal fixed point argument of the length given by 'flags', signed values are returned as magnitude
+static unsigned long long _arg_fixed(arg_type* args, unsigned int flags, bool is_signed, bool* negative)
+{
+  long long value;
+  *negative = false;
+  if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+    if (!is_signed) {
+      return _arg_ulong_long(args);
+    }
+    value = _arg_long_long(args);
+#else
+    return 0U;
+#endif
+  }
+  else if (flags & FLAGS_LONG) {
+    if (!is_signed) {
+      return _arg_ulong(args);
+    }
+    value = _arg_long(args);
+  }
+  else if (!is_signed) {
+    return (flags & FLAGS_CHAR) ? (unsigned char)_arg_uint(args) : (flags & FLAGS_SHORT) ? (unsigned short int)_arg_uint(args) : _arg_uint(args);
+  }
+  else {
+    value = (flags & FLAGS_CHAR) ? (char)_arg_int(args) : (flags & FLAGS_SHORT) ? (short int)_arg_int(args) : _arg_int(args);
+  }
+  *negative = value < 0;
+  return value > 0 ? (unsigned long long)value : 0U - (unsigned long long)value;
+}
+
+
+// internal format specifier parser, 'format' points behind the '%'
+// all flag adjustments depending on the type are resolved here, so the conversion needs no further parsing
+// \return Pointer behind the format specifier
+static const char* _parse_spec(const char* format, printf_spec_type* spec)
+{
+  unsigned int flags, n;
+
+  // evaluate flags
+  flags = 0U;
+  do {
+    switch (*format) {
+      case '0': flags |= FLAGS_ZEROPAD; format++; n = 1U; break;
+      case '-': flags |= FLAGS_LEFT;    format++; n = 1U; break;
+      case '+': flags |= FLAGS_PLUS;    format++; n = 1U; break;
+      case ' ': flags |= FLAGS_SPACE;   format++; n = 1U; break;
+      case '#': flags |= FLAGS_HASH;    format++; n = 1U; break;
+      default :                                   n = 0U; break;
+    }
+  } while (n);
+
+  // evaluate width field
+  spec->width = 0U;
+  if (_is_digit(*format)) {
+    spec->width = _atoi(&format);
+  }
+  else if (*format == '*') {
+    flags |= FLAGS_WIDTH_ARG;
+    format++;
+  }
+
+  // evaluate precision field
+  spec->precision = 0U;
+  if (*format == '.') {
+    flags |= FLAGS_PRECISION;
+    format++;
+    if (_is_digit(*format)) {
+      spec->precision = _atoi(&format);
+    }
+    else if (*format == '*') {
+      flags |= FLAGS_PRECISION_ARG;
+      format++;
+    }
+  }
+
+  // evaluate length field
+  switch (*format) {
+    case 'l' :
+      flags |= FLAGS_LONG;
+      format++;
+      if (*format == 'l') {
+        flags |= FLAGS_LONG_LONG;
+        format++;
+      }
+      break;
+    case 'h' :
+      flags |= FLAGS_SHORT;
+      format++;
+      if (*format == 'h') {
+        flags |= FLAGS_CHAR;
+        format++;
+      }
+      break;
+#if defined(PRINTF_SUPPORT_PTRDIFF_T)
+    case 't' :
+      flags |= (sizeof(ptrdiff_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
+      format++;
+      break;
+#endif
+    case 'j' :
+      flags |= (sizeof(intmax_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
+      format++;
+      break;
+    case 'z' :
+      flags |= (sizeof(size_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
+      format++;
+      break;
+    default :
+      break;
+  }
+
+  // evaluate type
+  switch (*format) {
+    case 'd' :
+    case 'i' :
+    case 'k' :
+      flags &= ~FLAGS_HASH;   // no hash for dec format
+      break;
+    case 'u' :
+    case 'K' :
+      flags &= ~(FLAGS_HASH | FLAGS_PLUS | FLAGS_SPACE);
+      break;
+    case 'X' :
+    case 'x' :
+    case 'o' :
+    case 'b' :
+      // no plus or space flag for u, x, X, o, b
+      flags &= ~(FLAGS_PLUS | FLAGS_SPACE);
+      if (*format == 'X') {
+        flags |= FLAGS_UPPERCASE;
+      }
+      break;
+    case 'F' :
+    case 'E' :
+    case 'R' :
+      flags |= FLAGS_UPPERCASE;
+      break;
+    case 'G' :
+      flags |= FLAGS_ADAPT_EXP | FLAGS_UPPERCASE;
+      break;
+    case 'g' :
+      flags |= FLAGS_ADAPT_EXP;
+      break;
+    case 'p' :
+      flags |= FLAGS_ZEROPAD | FLAGS_UPPERCASE;
+      break;
+    default :
+      break;
+  }
+
+  // ignore '0' flag when precision is given
+  switch (*format) {
+    case 'd' : case 'i' : case 'u' : case 'x' : case 'X' : case 'o' : case 'b' :
+      if (flags & FLAGS_PRECISION) {
+        flags &= ~FLAGS_ZEROPAD;
+      }
+      break;
+    default :
+      break;
+  }
+
+  spec->flags = flags;
+  spec->type  = *format;
+  spec->fbits = 0U;
+  if ((*format == 'k') || (*format == 'K')) {
+    // the number of fraction bits follows the fixed point type
+    format++;
+    if (_is_digit(*format)) {
+      spec->fbits = _atoi(&format);
+    }
+    return format;
+  }
+  // don't step over the terminating NUL of a dangling '%'
+  return *format ? format + 1 : format;
+}
+
+
+// internal resolution of the '*' width and precision arguments and of the length of typed array arguments
+// \return The final flags
+static unsigned int _resolve_spec(const printf_spec_type* spec, arg_type* args, unsigned int* width, unsigned int* precision)
+{
+  unsigned int flags = spec->flags;
+  *width     = spec->width;
+  *precision = spec->precision;
+
+  if (flags & FLAGS_WIDTH_ARG) {
+    const int w = _arg_int(args);
+    if (w < 0) {
+      flags |= FLAGS_LEFT;    // reverse padding
+      *width = (unsigned int)-w;
+    }
+    else {
+      *width = (unsigned int)w;
+    }
+  }
+  if (flags & FLAGS_PRECISION_ARG) {
+    const int prec = _arg_int(args);
+    *precision = prec > 0 ? (unsigned int)prec : 0U;
+  }
+
+  // typed array arguments carry their own width, without length modifier it selects the conversion
+  if (args->array && !(flags & (FLAGS_CHAR | FLAGS_SHORT | FLAGS_LONG | FLAGS_LONG_LONG))) {
+    switch (spec->type) {
+      case 'd' : case 'i' : case 'u' : case 'x' : case 'X' : case 'o' : case 'b' : case 'k' : case 'K' :
+        flags |= _arg_array_length(args);
+        break;
+      default :
+        break;
+    }
+  }
+
+  return flags;
+}
+
+
+// internal conversion of one argument according to the parsed format specifier
+static size_t _out_arg(out_fct_type out, char* buffer, size_t idx, size_t maxlen, const printf_spec_type* spec, arg_type* args)
+{
+  unsigned int width, precision;
+  unsigned int flags = _resolve_spec(spec, args, &width, &precision);
+
+  switch (spec->type) {
+    case 'd' :
+    case 'i' : {
+      // signed
+      if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+        const long long value = _arg_long_long(args);
+        idx = _ntoa_long_long(out, buffer, idx, maxlen, value > 0 ? (unsigned long long)value : 0U - (unsigned long long)value, value < 0, 10U, precision, width, flags);
+#endif
+      }
+      else if (flags & FLAGS_LONG) {
+        const long value = _arg_long(args);
+        idx = _ntoa_long(out, buffer, idx, maxlen, value > 0 ? (unsigned long)value : 0U - (unsigned long)value, value < 0, 10U, precision, width, flags);
+      }
+      else {
+        const int value = (flags & FLAGS_CHAR) ? (char)_arg_int(args) : (flags & FLAGS_SHORT) ? (short int)_arg_int(args) : _arg_int(args);
+        idx = _ntoa_long(out, buffer, idx, maxlen, value > 0 ? (unsigned int)value : 0U - (unsigned int)value, value < 0, 10U, precision, width, flags);
+      }
+      break;
+    }
+    case 'u' :
+    case 'x' :
+    case 'X' :
+    case 'o' :
+    case 'b' : {
+      // set the base
+      unsigned int base;
+      if (spec->type == 'x' || spec->type == 'X') {
+        base = 16U;
+      }
+      else if (spec->type == 'o') {
+        base =  8U;
+      }
+      else if (spec->type == 'b') {
+        base =  2U;
+      }
+      else {
+        base = 10U;
+      }
+      // unsigned
+      if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+        idx = _ntoa_long_long(out, buffer, idx, maxlen, _arg_ulong_long(args), false, base, precision, width, flags);
+#endif
+      }
+      else if (flags & FLAGS_LONG) {
+        idx = _ntoa_long(out, buffer, idx, maxlen, _arg_ulong(args), false, base, precision, width, flags);
+      }
+      else {
+        const unsigned int value = (flags & FLAGS_CHAR) ? (unsigned char)_arg_uint(args) : (flags & FLAGS_SHORT) ? (unsigned short int)_arg_uint(args) : _arg_uint(args);
+        idx = _ntoa_long(out, buffer, idx, maxlen, value, false, base, precision, width, flags);
+      }
+      break;
+    }
+    case 'k' :
+    case 'K' : {
+      // fixed point, signed or unsigned
+      bool negative;
+      const unsigned long long value = _arg_fixed(args, flags, spec->type == 'k', &negative);
+      idx = _qtoa(out, buffer, idx, maxlen, value, negative, spec->fbits, precision, width, flags);
+      break;
+    }
+#if defined(PRINTF_SUPPORT_FLOAT)
+    case 'f' :
+    case 'F' :
+#if defined(PRINTF_SUPPORT_FLOAT32)
+      if (flags & FLAGS_SHORT) {
+        idx = _ftoa32(out, buffer, idx, maxlen, _ftoa_float_bits(_arg_double(args)), precision, width, flags);
+        break;
+      }
+#endif
+      idx = _ftoa(out, buffer, idx, maxlen, _arg_double(args), precision, width, flags);
+      break;
+#if defined(PRINTF_SUPPORT_EXPONENTIAL)
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+      idx = _etoa(out, buffer, idx, maxlen, _arg_double(args), precision, width, flags);
+      break;
+#endif  // PRINTF_SUPPORT_EXPONENTIAL
+#if defined(PRINTF_SUPPORT_ROUNDTRIP)
+    case 'r':
+    case 'R':
+      idx = _rtoa(out, buffer, idx, maxlen, _arg_double(args), width, flags);
+      break;
+#endif  // PRINTF_SUPPORT_ROUNDTRIP
+#endif  // PRINTF_SUPPORT_FLOAT
+    case 'c' : {
+      const char c = (char)_arg_int(args);
+      // pre padding
+      if (!(flags & FLAGS_LEFT) && (width > 1U)) {
+        idx = _out_spaces(out, buffer, idx, maxlen, width - 1U);
+      }
+      // char output
+      out(&c, 1U, buffer, idx++, maxlen);
+      // post padding
+      if ((flags & FLAGS_LEFT) && (width > 1U)) {
+        idx = _out_spaces(out, buffer, idx, maxlen, width - 1U);
+      }
+      break;
+    }
+
+    case 's' : {
+      const char* p = _arg_string(args);
+      unsigned int l = _strnlen_s(p, precision ? precision : (size_t)-1);
+      // pre padding
+      if (flags & FLAGS_PRECISION) {
+        l = (l < precision ? l : precision);
+      }
+      if (!(flags & FLAGS_LEFT) && (l < width)) {
+        idx = _out_spaces(out, buffer, idx, maxlen, width - l);
+      }
+      // string output
+      out(p, l, buffer, idx, maxlen);
+      idx += l;
+      // post padding
+      if ((flags & FLAGS_LEFT) && (l < width)) {
+        idx = _out_spaces(out, buffer, idx, maxlen, width - l);
+      }
+      break;
+    }
+
+    case 'p' : {
+      width = _arg_pointer_width(args);
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+      const bool is_ll = sizeof(uintptr_t) == sizeof(long long);
+      if (is_ll) {
+        idx = _ntoa_long_long(out, buffer, idx, maxlen, _arg_pointer(args), false, 16U, precision, width, flags);
+      }
+      else {
+#endif
+        idx = _ntoa_long(out, buffer, idx, maxlen, (unsigned long)_arg_pointer(args), false, 16U, precision, width, flags);
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+      }
+#endif
+      break;
+    }
+
+    case 0 :
+      // dangling '%' at the end of the format string
+      break;
+
+    default :
+      // '%%' and unknown types are output as they are
+      out(&spec->type, 1U, buffer, idx++, maxlen);
+      break;
+  }
+
+  return idx;
+}
+
+
+// internal length of the conversion of one argument, computed without converting
+static size_t _measure_arg(const printf_spec_type* spec, arg_type* args)
+{
+  unsigned int width, precision;
+  const unsigned int flags = _resolve_spec(spec, args, &width, &precision);
+
+  switch (spec->type) {
+    case 'd' :
+    case 'i' : {
+      long long value;
+      if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+        value = _arg_long_long(args);
+#else
+        return 0U;
+#endif
+      }
+      else if (flags & FLAGS_LONG) {
+        value = _arg_long(args);
+      }
+      else {
+        value = (flags & FLAGS_CHAR) ? (char)_arg_int(args) : (flags & FLAGS_SHORT) ? (short int)_arg_int(args) : _arg_int(args);
+      }
+      return _ntoa_len(value > 0 ? (unsigned long long)value : 0U - (unsigned long long)value, value < 0, 10U, precision, width, flags);
+    }
+    case 'u' :
+    case 'x' :
+    case 'X' :
+    case 'o' :
+    case 'b' : {
+      const unsigned int base = (spec->type == 'x' || spec->type == 'X') ? 16U : (spec->type == 'o') ? 8U : (spec->type == 'b') ? 2U : 10U;
+      unsigned long long value;
+      if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+        value = _arg_ulong_long(args);
+#else
+        return 0U;
+#endif
+      }
+      else if (flags & FLAGS_LONG) {
+        value = _arg_ulong(args);
+      }
+      else {
+        value = (flags & FLAGS_CHAR) ? (unsigned char)_arg_uint(args) : (flags & FLAGS_SHORT) ? (unsigned short int)_arg_uint(args) : _arg_uint(args);
+      }
+      return _ntoa_len(value, false, base, precision, width, flags);
+    }
+    case 'k' :
+    case 'K' : {
+      // the rounding may carry into the whole part, so the length depends on the conversion itself
+      bool negative;
+      const unsigned long long value = _arg_fixed(args, flags, spec->type == 'k', &negative);
+      return _qtoa(_out_null, NULL, 0U, 0U, value, negative, spec->fbits, precision, width, flags);
+    }
+#if defined(PRINTF_SUPPORT_FLOAT)
+    case 'f' :
+    case 'F' :
+#if defined(PRINTF_SUPPORT_FLOAT32)
+      if (flags & FLAGS_SHORT) {
+        return _ftoa32_len(_ftoa_float_bits(_arg_double(args)), precision, width, flags);
+      }
+#endif
+      return _ftoa_len(_arg_double(args), precision, width, flags);
+#if defined(PRINTF_SUPPORT_EXPONENTIAL)
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+      // the exponent and the %g mode selection depend on the conversion itself
+      return _etoa(_out_null, NULL, 0U, 0U, _arg_double(args), precision, width, flags);
+#endif  // PRINTF_SUPPORT_EXPONENTIAL
+#if defined(PRINTF_SUPPORT_ROUNDTRIP)
+    case 'r':
+    case 'R':
+      return _rtoa(_out_null, NULL, 0U, 0U, _arg_double(args), width, flags);
+#endif  // PRINTF_SUPPORT_ROUNDTRIP
+#endif  // PRINTF_SUPPORT_FLOAT
+    case 'c' :
+      (void)_arg_int(args);
+      return width > 1U ? width : 1U;
+    case 's' : {
+      const char* p = _arg_string(args);
+      size_t l = _strnlen_s(p, precision ? precision : (size_t)-1);
+      if (flags & FLAGS_PRECISION) {
+        l = (l < precision ? l : precision);
+      }
+      return l < width ? width : l;
+    }
+    case 'p' : {
+      const unsigned int digits = _arg_pointer_width(args);
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+      return _ntoa_len(_arg_pointer(args), false, 16U, precision, digits, flags);
+#else
+      return _ntoa_len((unsigned long)_arg_pointer(args), false, 16U, precision, digits, flags);
+#endif
+    }
+    case 0 :
+      return 0U;
+    default :
+      return 1U;
+  }
+}
+
+
+// internal measuring engine, the length of the formatted output computed without generating it
+PRINTF_ENGINE_SHARED static int _measure(const char* format, arg_type* args)
+{
+  printf_spec_type spec;
+  size_t len = 0U;
+
+  while (*format) {
+    if (*format != '%') {
+      const char* run = format;
+      format = _scan_literal(format);
+      len += (size_t)(format - run);
+      continue;
+    }
+    format = _parse_spec(format + 1, &spec);
+    len += _measure_arg(&spec, args);
+  }
+  return (int)len;
+}
+
+
+// internal measuring engine for pre-parsed formats
+static int _measure_compiled(const printf_op_type* ops, arg_type* args)
+{
+  size_t len = 0U;
+  for (;; ++ops) {
+    len += ops->len;
+    if (!ops->spec.type) {
+      break;
+    }
+    len += _measure_arg(&ops->spec, args);
+  }
+  return (int)len;
+}
+
+
+// internal format engine, the arguments are read from 'args'
+static int _format(out_fct_type out, char* buffer, const size_t maxlen, const char* format, arg_type* args)
+{
+  printf_spec_type spec;
+  size_t idx = 0U;
+
+  if (!buffer) {
+    // only the length is wanted
+    return _measure(format, args);
+  }
+
+  while (*format)
+  {
+    // format specifier?  %[flags][width][.precision][length]
+    if (*format != '%') {
+      // no, output the literal run up to the next specifier as one span
+      const char* run = format;
+      format = _scan_literal(format);
+      out(run, (size_t)(format - run), buffer, idx, maxlen);
+      idx += (size_t)(format - run);
+      continue;
+    }
+
+    // yes, evaluate it
+    format = _parse_spec(format + 1, &spec);
+    idx = _out_arg(out, buffer, idx, maxlen, &spec, args);
+  }
+
+  // termination
+  out(NULL, 0U, buffer, idx < maxlen ? idx : maxlen - 1U, maxlen);
+
+  // return written chars without terminating \0
+  return (int)idx;
+}
+
+
+// internal format engine of snprintf_trunc(), stops as soon as the buffer is full
+// \return The number of characters written, not counting the terminating null character, -1 on truncation
+static int _format_trunc(char* buffer, size_t maxlen, const char* format, arg_type* args)
+{
+  printf_spec_type spec;
+  size_t idx = 0U;
+
+  if (!buffer) {
+    maxlen = 0U;
+  }
+  // last index for characters, the terminating null character needs the slot behind them
+  const size_t end = maxlen ? maxlen - 1U : 0U;
+
+  while (*format && (idx <= end)) {
+    if (*format != '%') {
+      const char* run = format;
+      format = _scan_literal(format);
+      _out_buffer(run, (size_t)(format - run), buffer, idx, maxlen);
+      idx += (size_t)(format - run);
+      continue;
+    }
+
+    // resolve the '*' arguments up front, the converter gets the final width and precision
+    format = _parse_spec(format + 1, &spec);
+    spec.flags = _resolve_spec(&spec, args, &spec.width, &spec.precision) & ~(FLAGS_WIDTH_ARG | FLAGS_PRECISION_ARG);
+    if (spec.type == 's') {
+      // string characters beyond the remaining space and beyond the width can't change the output,
+      // so the length scan is bounded by them
+      const size_t room  = end - idx + 1U;
+      const size_t bound = room > spec.width ? room : spec.width;
+      if ((bound < (unsigned int)-1) && (!(spec.flags & FLAGS_PRECISION) || (spec.precision > bound))) {
+        spec.flags    |= FLAGS_PRECISION;
+        spec.precision = (unsigned int)bound;
+      }
+    }
+    idx = _out_arg(_out_buffer, buffer, idx, maxlen, &spec, args);
+  }
+
+  if (maxlen) {
+    _out_buffer(NULL, 0U, buffer, idx <= end ? idx : end, maxlen);
+  }
+  return idx <= end ? (int)idx : -1;
+}
+
+
+// internal vsnprintf
+static int _vsnprintf(out_fct_type out, char* buffer, const size_t maxlen, const char* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format(out, buffer, maxlen, format, &args);
+  va_end(args.va);
+  return ret;
+}
+
+
+// internal instances of _vsnprintf() with a fixed output function, see PRINTF_SPECIALIZE_OUTPUT
+// (each one copies the va_list itself, GCC does not inline a callee with va_copy() into a flattened function)
+PRINTF_ENGINE_INSTANCE int _vsnprintf_buffer(char* buffer, const size_t maxlen, const char* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format(_out_buffer, buffer, maxlen, format, &args);
+  va_end(args.va);
+  return ret;
+}
+
+
+PRINTF_ENGINE_INSTANCE int _vsnprintf_unbounded(char* buffer, const size_t maxlen, const char* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format(_out_buffer_unbounded, buffer, maxlen, format, &args);
+  va_end(args.va);
+  return ret;
+}
+
+
+PRINTF_ENGINE_INSTANCE int _vsnprintf_char(char* buffer, const size_t maxlen, const char* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format(_out_char, buffer, maxlen, format, &args);
+  va_end(args.va);
+  return ret;
+}
+
+
+// internal format engine for pre-parsed formats, the arguments are read from 'args'
+static int _format_compiled(out_fct_type out, char* buffer, const size_t maxlen, const printf_op_type* ops, arg_type* args)
+{
+  size_t idx = 0U;
+
+  if (!buffer) {
+    // only the length is wanted
+    return _measure_compiled(ops, args);
+  }
+
+  for (;; ++ops) {
+    // literal text in front of the conversion
+    out(ops->text, ops->len, buffer, idx, maxlen);
+    idx += ops->len;
+    if (!ops->spec.type) {
+      break;
+    }
+    idx = _out_arg(out, buffer, idx, maxlen, &ops->spec, args);
+  }
+
+  // termination
+  out(NULL, 0U, buffer, idx < maxlen ? idx : maxlen - 1U, maxlen);
+
+  // return written chars without terminating \0
+  return (int)idx;
+}
+
+
+#if defined(PRINTF_SUPPORT_BINARY)
+// internal write of an LEB128 encoded value to the binary record
+static size_t _bin_write(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long long value)
+{
+  char buf[10];
+  size_t len = 0U;
+  do {
+    buf[len++] = (char)((value & 0x7FU) | (value > 0x7FU ? 0x80U : 0U));
+    value >>= 7U;
+  } while (value);
+  out(buf, len, buffer, idx, maxlen);
+  return idx + len;
+}
+
+
+// internal write of a zigzag LEB128 encoded value to the binary record
+static size_t _bin_write_signed(out_fct_type out, char* buffer, size_t idx, size_t maxlen, long long value)
+{
+  const unsigned long long zigzag = (unsigned long long)value << 1U;
+  return _bin_write(out, buffer, idx, maxlen, value < 0 ? ~zigzag : zigzag);
+}
+
+
+// internal binary record encoder
+// walks the format string only to classify the arguments and stores the key (format pointer or dictionary ID)
+// followed by the raw argument values, in the order and encoding _arg_*() reads them back
+static int _binprintf(out_fct_type out, char* buffer, const size_t maxlen, uintptr_t key, const char* format, va_list va)
+{
+  printf_spec_type spec;
+  size_t idx = 0U;
+
+  if (!buffer) {
+    // use null output function
+    out = _out_null;
+  }
+
+  idx = _bin_write(out, buffer, idx, maxlen, key);
+
+  while (*(format = _scan_literal(format))) {
+    format = _parse_spec(format + 1, &spec);
+    const unsigned int flags = spec.flags;
+    unsigned int precision   = spec.precision;
+
+    if (flags & FLAGS_WIDTH_ARG) {
+      idx = _bin_write_signed(out, buffer, idx, maxlen, va_arg(va, int));
+    }
+    if (flags & FLAGS_PRECISION_ARG) {
+      const int prec = va_arg(va, int);
+      precision = prec > 0 ? (unsigned int)prec : 0U;
+      idx = _bin_write_signed(out, buffer, idx, maxlen, prec);
+    }
+
+    switch (spec.type) {
+      case 'd' :
+      case 'i' :
+      case 'k' :
+        if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+          idx = _bin_write_signed(out, buffer, idx, maxlen, va_arg(va, long long));
+#endif
+        }
+        else if (flags & FLAGS_LONG) {
+          idx = _bin_write_signed(out, buffer, idx, maxlen, va_arg(va, long));
+        }
+        else {
+          idx = _bin_write_signed(out, buffer, idx, maxlen, va_arg(va, int));
+        }
+        break;
+      case 'u' :
+      case 'x' :
+      case 'X' :
+      case 'o' :
+      case 'b' :
+      case 'K' :
+        if (flags & FLAGS_LONG_LONG) {
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+          idx = _bin_write(out, buffer, idx, maxlen, va_arg(va, unsigned long long));
+#endif
+        }
+        else if (flags & FLAGS_LONG) {
+          idx = _bin_write(out, buffer, idx, maxlen, va_arg(va, unsigned long));
+        }
+        else {
+          idx = _bin_write(out, buffer, idx, maxlen, va_arg(va, unsigned int));
+        }
+        break;
+#if defined(PRINTF_SUPPORT_FLOAT)
+      case 'f' :
+      case 'F' :
+#if defined(PRINTF_SUPPORT_EXPONENTIAL)
+      case 'e' :
+      case 'E' :
+      case 'g' :
+      case 'G' :
+#endif
+#if defined(PRINTF_SUPPORT_ROUNDTRIP)
+      case 'r' :
+      case 'R' :
+#endif
+      {
+        // IEEE-754 bits, little endian
+        union {
+          uint64_t U;
+          double   F;
+        } conv;
+        char buf[8];
+        conv.F = va_arg(va, double);
+        for (unsigned int i = 0U; i < 8U; ++i) {
+          buf[i] = (char)(conv.U >> (8U * i));
+        }
+        out(buf, 8U, buffer, idx, maxlen);
+        idx += 8U;
+        break;
+      }
+#endif  // PRINTF_SUPPORT_FLOAT
+      case 'c' :
+        idx = _bin_write_signed(out, buffer, idx, maxlen, va_arg(va, int));
+        break;
+      case 's' : {
+        // store the string inline, as the pointer is meaningless to the decoder
+        const char* p = va_arg(va, char*);
+        if (!p) {
+          p = "(null)";
+        }
+        unsigned int l = _strnlen_s(p, precision ? precision : (size_t)-1);
+        if (flags & FLAGS_PRECISION) {
+          l = (l < precision ? l : precision);
+        }
+        out(p, l, buffer, idx, maxlen);
+        out("", 1U, buffer, idx + l, maxlen);
+        idx += l + 1U;
+        break;
+      }
+      case 'p' :
+        // the pointer size first, the host prints the pointer with the width of the target
+        idx = _bin_write(out, buffer, idx, maxlen, sizeof(void*));
+        idx = _bin_write(out, buffer, idx, maxlen, (uintptr_t)va_arg(va, void*));
+        break;
+      default :
+        break;
+    }
+  }
+
+  return (int)idx;
+}
+#endif  // PRINTF_SUPPORT_BINARY
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+int printf_(const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  char buffer[1];
+  const int ret = _vsnprintf_char(buffer, (size_t)-1, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int sprintf_(char* buffer, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = _vsnprintf_unbounded(buffer, (size_t)-1, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int snprintf_(char* buffer, size_t count, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = _vsnprintf_buffer(buffer, count, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int vprintf_(const char* format, va_list va)
+{
+  char buffer[1];
+  return _vsnprintf_char(buffer, (size_t)-1, format, va);
+}
+
+
+int vsnprintf_(char* buffer, size_t count, const char* format, va_list va)
+{
+  return _vsnprintf_buffer(buffer, count, format, va);
+}
+
+
+#if defined(PRINTF_SUPPORT_TRY_PRINTF)
+// number of lines try_printf() dropped since the last report, shared by all callers
+static unsigned int _try_dropped = 0U;
+
+
+// internal take over of the drop count, atomic with GCC and clang, so a caller which preempts another one
+// neither loses drops nor reports them twice
+static inline unsigned int _try_dropped_take(void)
+{
+#if defined(__GNUC__)
+  return __atomic_exchange_n(&_try_dropped, 0U, __ATOMIC_RELAXED);
+#else
+  const unsigned int dropped = _try_dropped;
+  _try_dropped = 0U;
+  return dropped;
+#endif
+}
+
+
+// internal give back of drops which weren't reported
+static inline void _try_dropped_add(unsigned int count)
+{
+#if defined(__GNUC__)
+  __atomic_fetch_add(&_try_dropped, count, __ATOMIC_RELAXED);
+#else
+  _try_dropped += count;
+#endif
+}
+
+
+int try_printf(const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = try_vprintf(format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int try_vprintf(const char* format, va_list va)
+{
+  va_list measure_va;
+  va_copy(measure_va, va);
+  const int len = vprintf_measure(format, measure_va);
+  va_end(measure_va);
+
+  // the report of the lines dropped before has to fit in front of this line
+  char report[32];
+  size_t report_len = 0U;
+  const unsigned int dropped = _try_dropped_take();
+  if (dropped) {
+    report_len = (size_t)snprintf_(report, sizeof(report), PRINTF_TRY_DROPPED_FORMAT, dropped);
+    report_len = report_len < sizeof(report) ? report_len : sizeof(report) - 1U;
+  }
+  if ((len < 0) || (_putchar_room() < report_len + (size_t)len)) {
+    // give the drops back, together with this line
+    _try_dropped_add(dropped < (unsigned int)-1 ? dropped + 1U : dropped);
+    return -1;
+  }
+
+  if (report_len) {
+    _out_char(report, report_len, NULL, 0U, 0U);
+  }
+  char buffer[1];
+  return _vsnprintf_char(buffer, (size_t)-1, format, va);
+}
+#endif  // PRINTF_SUPPORT_TRY_PRINTF
+
+
+int sprintf_sized(char* buffer, size_t size, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = vsprintf_sized(buffer, size, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int vsprintf_sized(char* buffer, size_t size, const char* format, va_list va)
+{
+#if defined(PRINTF_SPRINTF_SIZED_CHECK)
+  // verify the size once per call, instead of a bounds check per character
+  va_list measure_va;
+  va_copy(measure_va, va);
+  const int len = vprintf_measure(format, measure_va);
+  va_end(measure_va);
+  assert((len >= 0) && ((size_t)len < size));
+#endif
+  (void)size;
+  return _vsnprintf_unbounded(buffer, (size_t)-1, format, va);
+}
+
+
+int snprintf_trunc(char* buffer, size_t count, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = vsnprintf_trunc(buffer, count, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int vsnprintf_trunc(char* buffer, size_t count, const char* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format_trunc(buffer, count, format, &args);
+  va_end(args.va);
+  return ret;
+}
+
+
+int printf_measure(const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = _vsnprintf(_out_null, NULL, 0U, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int vprintf_measure(const char* format, va_list va)
+{
+  return _vsnprintf(_out_null, NULL, 0U, format, va);
+}
+
+
+int fctprintf(void (*out)(char character, void* arg), void* arg, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const out_fct_wrap_type out_fct_wrap = { out, arg };
+  const int ret = _vsnprintf(_out_fct, (char*)(uintptr_t)&out_fct_wrap, (size_t)-1, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+int fctprintf_span(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const out_span_wrap_type out_span_wrap = { out, arg };
+  const int ret = _vsnprintf(_out_fct_span, (char*)(uintptr_t)&out_span_wrap, (size_t)-1, format, va);
+  va_end(va);
+  return ret;
+}
+
+
+// wrapper (used as buffer) for the resumable output, 'idx' counts the characters of the current conversion
+typedef struct {
+  size_t (*fct)(const char* data, size_t len, void* arg);
+  void*  arg;
+  size_t skip;      // characters of the conversion which a former call has written
+  size_t written;   // characters of the conversion written when the output function was full
+  bool   full;
+} out_resume_wrap_type;
+
+
+// internal resumable output, skips what was written before and stops at the first short write
+static void _out_resume(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
+{
+  out_resume_wrap_type* wrap = (out_resume_wrap_type*)buffer;
+  (void)maxlen;
+  if (!data || wrap->full || (idx + len <= wrap->skip)) {
+    return;
+  }
+  const size_t from = (idx < wrap->skip) ? wrap->skip - idx : 0U;
+  const size_t n    = wrap->fct(data + from, len - from, wrap->arg);
+  if (n < len - from) {
+    wrap->full    = true;
+    wrap->written = idx + from + n;
+  }
+}
+
+
+void printf_resume_init(printf_resume_type* state, const char* format, const printf_arg_type* args, size_t nargs)
+{
+  state->format    = format;
+  state->skip      = 0U;
+  state->idx       = 0U;
+  state->array     = args ? args : &_arg_none;
+  state->array_end = args ? args + nargs : &_arg_none;
+  state->data      = NULL;
+  state->end       = NULL;
+  state->has_va    = 0;
+}
+
+
+void vprintf_resume_init(printf_resume_type* state, const char* format, va_list va)
+{
+  printf_resume_init(state, format, NULL, 0U);
+  state->array     = NULL;
+  state->array_end = NULL;
+  state->has_va    = 1;
+  va_copy(state->va, va);
+}
+
+
+#if defined(PRINTF_SUPPORT_BINARY)
+void printf_resume_init_binary(printf_resume_type* state, const char* format, const void* args, size_t size)
+{
+  printf_resume_init(state, format, NULL, 0U);
+  state->array = NULL;
+  state->data  = args;
+  state->end   = (const unsigned char*)args + size;
+}
+#endif
+
+
+int printf_resume(printf_resume_type* state, size_t (*out)(const char* data, size_t len, void* arg), void* arg)
+{
+  while (*state->format) {
+    if (*state->format != '%') {
+      // a literal run resumes right behind the characters written
+      const size_t len = (size_t)(_scan_literal(state->format) - state->format);
+      const size_t n   = out(state->format, len, arg);
+      state->format += n;
+      state->idx    += n;
+      if (n < len) {
+        return 1;
       }
-      flags |= FLAGS_PRECISION;   // make sure _ftoa respects precision
-      // no characters in exponent
-      minwidth = 0U;
-      expval   = 0;
+      continue;
     }
-    else {
-      // we use one sigfig for the whole part
-      if ((prec > 0) && (flags & FLAGS_PRECISION)) {
-        --prec;
+
+    // a conversion is converted from its arguments again until it is written completely
+    printf_spec_type spec;
+    const char* next = _parse_spec(state->format + 1, &spec);
+    arg_type args;
+    args.array     = state->array;
+    args.array_end = state->array_end;
+#if defined(PRINTF_SUPPORT_BINARY)
+    args.data = (const unsigned char*)state->data;
+    args.end  = (const unsigned char*)state->end;
+#endif
+    if (state->has_va) {
+      va_copy(args.va, state->va);
+    }
+    out_resume_wrap_type wrap = { out, arg, state->skip, 0U, false };
+    const size_t len = _out_arg(_out_resume, (char*)&wrap, 0U, (size_t)-1, &spec, &args);
+    if (wrap.full) {
+      state->idx += wrap.written - state->skip;
+      state->skip = wrap.written;
+      if (state->has_va) {
+        va_end(args.va);
       }
+      return 1;
     }
-  }
 
-  // will everything fit?
-  unsigned int fwidth = width;
-  if (width > minwidth) {
-    // we didn't fall-back so subtract the characters required for the exponent
-    fwidth -= minwidth;
-  } else {
-    // not enough characters, so go back to default sizing
-    fwidth = 0U;
-  }
-  if ((flags & FLAGS_LEFT) && minwidth) {
-    // if we're padding on the right, DON'T pad the floating part
-    fwidth = 0U;
+    // done, continue with the arguments behind it
+    state->idx      += len - state->skip;
+    state->skip      = 0U;
+    state->format    = next;
+    state->array     = args.array;
+#if defined(PRINTF_SUPPORT_BINARY)
+    state->data = args.data;
+#endif
+    if (state->has_va) {
+      va_end(state->va);
+      va_copy(state->va, args.va);
+      va_end(args.va);
+    }
   }
 
-  // rescale the float value
-  if (expval) {
-    value /= conv.F;
+  if (state->has_va) {
+    va_end(state->va);
+    state->has_va = 0;
   }
+  return 0;
+}
 
-  // output the floating part
-  const size_t start_idx = idx;
-  idx = _ftoa(out, buffer, idx, maxlen, negative ? -value : value, prec, fwidth, flags & ~FLAGS_ADAPT_EXP);
 
-  // output the exponent part
-  if (minwidth) {
-    // output the exponential symbol
-    out((flags & FLAGS_UPPERCASE) ? 'E' : 'e', buffer, idx++, maxlen);
-    // output the exponent value
-    idx = _ntoa_long(out, buffer, idx, maxlen, (expval < 0) ? -expval : expval, expval < 0, 10, 0, minwidth-1, FLAGS_ZEROPAD | FLAGS_PLUS);
-    // might need to right-pad spaces
-    if (flags & FLAGS_LEFT) {
-      while (idx - start_idx < width) out(' ', buffer, idx++, maxlen);
+int printf_compile(printf_op_type* ops, size_t count, const char* format)
+{
+  size_t n = 0U;
+  printf_op_type op;
+  do {
+    // literal run, followed by a conversion or the end of the format
+    op.text = format;
+    format  = _scan_literal(format);
+    op.len  = (size_t)(format - op.text);
+    if (*format) {
+      format = _parse_spec(format + 1, &op.spec);
+    }
+    else {
+      op.spec.flags = op.spec.width = op.spec.precision = op.spec.fbits = 0U;
+      op.spec.type  = 0;
+    }
+    if (n < count) {
+      ops[n] = op;
     }
+    n++;
+  } while (op.spec.type);
+
+  if ((n > count) && count) {
+    // too small, leave a handle that outputs nothing
+    ops[0].text      = "";
+    ops[0].len       = 0U;
+    ops[0].spec.type = 0;
   }
-  return idx;
+  return (int)n;
 }
-#endif  // PRINTF_SUPPORT_EXPONENTIAL
-#endif  // PRINTF_SUPPORT_FLOAT
 
 
-// internal vsnprintf
-static int _vsnprintf(out_fct_type out, char* buffer, const size_t maxlen, const char* format, va_list va)
+int snprintf_compiled(char* buffer, size_t count, const printf_op_type* format, ...)
 {
-  unsigned int flags, width, precision, n;
-  size_t idx = 0U;
+  va_list va;
+  va_start(va, format);
+  const int ret = vsnprintf_compiled(buffer, count, format, va);
+  va_end(va);
+  return ret;
+}
 
-  if (!buffer) {
-    // use null output function
-    out = _out_null;
-  }
 
-  while (*format)
-  {
-    // format specifier?  %[flags][width][.precision][length]
-    if (*format != '%') {
-      // no
-      out(*format, buffer, idx++, maxlen);
-      format++;
-      continue;
-    }
-    else {
-      // yes, evaluate it
-      format++;
-    }
+int vsnprintf_compiled(char* buffer, size_t count, const printf_op_type* format, va_list va)
+{
+  arg_type args;
+  va_copy(args.va, va);
+  args.array     = NULL;
+  args.array_end = NULL;
+#if defined(PRINTF_SUPPORT_BINARY)
+  args.data = NULL;
+  args.end  = NULL;
+#endif
+  const int ret = _format_compiled(_out_buffer, buffer, count, format, &args);
+  va_end(args.va);
+  return ret;
+}
 
-    // evaluate flags
-    flags = 0U;
-    do {
-      switch (*format) {
-        case '0': flags |= FLAGS_ZEROPAD; format++; n = 1U; break;
-        case '-': flags |= FLAGS_LEFT;    format++; n = 1U; break;
-        case '+': flags |= FLAGS_PLUS;    format++; n = 1U; break;
-        case ' ': flags |= FLAGS_SPACE;   format++; n = 1U; break;
-        case '#': flags |= FLAGS_HASH;    format++; n = 1U; break;
-        default :                                   n = 0U; break;
-      }
-    } while (n);
 
-    // evaluate width field
-    width = 0U;
-    if (_is_digit(*format)) {
-      width = _atoi(&format);
-    }
-    else if (*format == '*') {
-      const int w = va_arg(va, int);
-      if (w < 0) {
-        flags |= FLAGS_LEFT;    // reverse padding
-        width = (unsigned int)-w;
-      }
-      else {
-        width = (unsigned int)w;
-      }
-      format++;
-    }
+int snprintf_args(char* buffer, size_t count, const printf_op_type* format, const printf_arg_type* args, size_t nargs)
+{
+  arg_type array_args;
+  array_args.array     = args ? args : &_arg_none;
+  array_args.array_end = args ? args + nargs : &_arg_none;
+#if defined(PRINTF_SUPPORT_BINARY)
+  array_args.data = NULL;
+  array_args.end  = NULL;
+#endif
+  return _format_compiled(_out_buffer, buffer, count, format, &array_args);
+}
 
-    // evaluate precision field
-    precision = 0U;
-    if (*format == '.') {
-      flags |= FLAGS_PRECISION;
-      format++;
-      if (_is_digit(*format)) {
-        precision = _atoi(&format);
-      }
-      else if (*format == '*') {
-        const int prec = (int)va_arg(va, int);
-        precision = prec > 0 ? (unsigned int)prec : 0U;
-        format++;
-      }
-    }
 
-    // evaluate length field
-    switch (*format) {
-      case 'l' :
-        flags |= FLAGS_LONG;
-        format++;
-        if (*format == 'l') {
-          flags |= FLAGS_LONG_LONG;
-          format++;
-        }
-        break;
-      case 'h' :
-        flags |= FLAGS_SHORT;
-        format++;
-        if (*format == 'h') {
-          flags |= FLAGS_CHAR;
-          format++;
-        }
-        break;
-#if defined(PRINTF_SUPPORT_PTRDIFF_T)
-      case 't' :
-        flags |= (sizeof(ptrdiff_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
-        format++;
-        break;
+int snprintf_typed(char* buffer, size_t count, const char* format, const printf_arg_type* args, size_t nargs)
+{
+  arg_type array_args;
+  array_args.array     = args ? args : &_arg_none;
+  array_args.array_end = args ? args + nargs : &_arg_none;
+#if defined(PRINTF_SUPPORT_BINARY)
+  array_args.data = NULL;
+  array_args.end  = NULL;
 #endif
-      case 'j' :
-        flags |= (sizeof(intmax_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
-        format++;
-        break;
-      case 'z' :
-        flags |= (sizeof(size_t) == sizeof(long) ? FLAGS_LONG : FLAGS_LONG_LONG);
-        format++;
-        break;
-      default :
-        break;
-    }
+  return _format(_out_buffer, buffer, count, format, &array_args);
+}
 
-    // evaluate specifier
-    switch (*format) {
-      case 'd' :
-      case 'i' :
-      case 'u' :
-      case 'x' :
-      case 'X' :
-      case 'o' :
-      case 'b' : {
-        // set the base
-        unsigned int base;
-        if (*format == 'x' || *format == 'X') {
-          base = 16U;
-        }
-        else if (*format == 'o') {
-          base =  8U;
-        }
-        else if (*format == 'b') {
-          base =  2U;
-        }
-        else {
-          base = 10U;
-          flags &= ~FLAGS_HASH;   // no hash for dec format
-        }
-        // uppercase
-        if (*format == 'X') {
-          flags |= FLAGS_UPPERCASE;
-        }
 
-        // no plus or space flag for u, x, X, o, b
-        if ((*format != 'i') && (*format != 'd')) {
-          flags &= ~(FLAGS_PLUS | FLAGS_SPACE);
-        }
+size_t printf_kernel_ntoa_long(char* buffer, size_t idx, size_t maxlen, unsigned long value, int negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ntoa_long(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, negative != 0, base, prec, width, flags);
+}
 
-        // ignore '0' flag when precision is given
-        if (flags & FLAGS_PRECISION) {
-          flags &= ~FLAGS_ZEROPAD;
-        }
 
-        // convert the integer
-        if ((*format == 'i') || (*format == 'd')) {
-          // signed
-          if (flags & FLAGS_LONG_LONG) {
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-            const long long value = va_arg(va, long long);
-            idx = _ntoa_long_long(out, buffer, idx, maxlen, (unsigned long long)(value > 0 ? value : 0 - value), value < 0, base, precision, width, flags);
-#endif
-          }
-          else if (flags & FLAGS_LONG) {
-            const long value = va_arg(va, long);
-            idx = _ntoa_long(out, buffer, idx, maxlen, (unsigned long)(value > 0 ? value : 0 - value), value < 0, base, precision, width, flags);
-          }
-          else {
-            const int value = (flags & FLAGS_CHAR) ? (char)va_arg(va, int) : (flags & FLAGS_SHORT) ? (short int)va_arg(va, int) : va_arg(va, int);
-            idx = _ntoa_long(out, buffer, idx, maxlen, (unsigned int)(value > 0 ? value : 0 - value), value < 0, base, precision, width, flags);
-          }
-        }
-        else {
-          // unsigned
-          if (flags & FLAGS_LONG_LONG) {
 #if defined(PRINTF_SUPPORT_LONG_LONG)
-            idx = _ntoa_long_long(out, buffer, idx, maxlen, va_arg(va, unsigned long long), false, base, precision, width, flags);
-#endif
-          }
-          else if (flags & FLAGS_LONG) {
-            idx = _ntoa_long(out, buffer, idx, maxlen, va_arg(va, unsigned long), false, base, precision, width, flags);
-          }
-          else {
-            const unsigned int value = (flags & FLAGS_CHAR) ? (unsigned char)va_arg(va, unsigned int) : (flags & FLAGS_SHORT) ? (unsigned short int)va_arg(va, unsigned int) : va_arg(va, unsigned int);
-            idx = _ntoa_long(out, buffer, idx, maxlen, value, false, base, precision, width, flags);
-          }
-        }
-        format++;
-        break;
-      }
+size_t printf_kernel_ntoa_long_long(char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ntoa_long_long(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, negative != 0, base, prec, width, flags);
+}
+#endif
+
+
+size_t printf_kernel_qtoa(char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned int bits, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _qtoa(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, negative != 0, bits, prec, width, flags);
+}
+
+
 #if defined(PRINTF_SUPPORT_FLOAT)
-      case 'f' :
-      case 'F' :
-        if (*format == 'F') flags |= FLAGS_UPPERCASE;
-        idx = _ftoa(out, buffer, idx, maxlen, va_arg(va, double), precision, width, flags);
-        format++;
-        break;
-#if defined(PRINTF_SUPPORT_EXPONENTIAL)
-      case 'e':
-      case 'E':
-      case 'g':
-      case 'G':
-        if ((*format == 'g')||(*format == 'G')) flags |= FLAGS_ADAPT_EXP;
-        if ((*format == 'E')||(*format == 'G')) flags |= FLAGS_UPPERCASE;
-        idx = _etoa(out, buffer, idx, maxlen, va_arg(va, double), precision, width, flags);
-        format++;
-        break;
-#endif  // PRINTF_SUPPORT_EXPONENTIAL
-#endif  // PRINTF_SUPPORT_FLOAT
-      case 'c' : {
-        unsigned int l = 1U;
-        // pre padding
-        if (!(flags & FLAGS_LEFT)) {
-          while (l++ < width) {
-            out(' ', buffer, idx++, maxlen);
-          }
-        }
-        // char output
-        out((char)va_arg(va, int), buffer, idx++, maxlen);
-        // post padding
-        if (flags & FLAGS_LEFT) {
-          while (l++ < width) {
-            out(' ', buffer, idx++, maxlen);
-          }
-        }
-        format++;
-        break;
-      }
+size_t printf_kernel_ftoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ftoa(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, prec, width, flags);
+}
 
-      case 's' : {
-        const char* p = va_arg(va, char*);
-        unsigned int l = _strnlen_s(p, precision ? precision : (size_t)-1);
-        // pre padding
-        if (flags & FLAGS_PRECISION) {
-          l = (l < precision ? l : precision);
-        }
-        if (!(flags & FLAGS_LEFT)) {
-          while (l++ < width) {
-            out(' ', buffer, idx++, maxlen);
-          }
-        }
-        // string output
-        while ((*p != 0) && (!(flags & FLAGS_PRECISION) || precision--)) {
-          out(*(p++), buffer, idx++, maxlen);
-        }
-        // post padding
-        if (flags & FLAGS_LEFT) {
-          while (l++ < width) {
-            out(' ', buffer, idx++, maxlen);
-          }
-        }
-        format++;
-        break;
-      }
 
-      case 'p' : {
-        width = sizeof(void*) * 2U;
-        flags |= FLAGS_ZEROPAD | FLAGS_UPPERCASE;
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-        const bool is_ll = sizeof(uintptr_t) == sizeof(long long);
-        if (is_ll) {
-          idx = _ntoa_long_long(out, buffer, idx, maxlen, (uintptr_t)va_arg(va, void*), false, 16U, precision, width, flags);
-        }
-        else {
-#endif
-          idx = _ntoa_long(out, buffer, idx, maxlen, (unsigned long)((uintptr_t)va_arg(va, void*)), false, 16U, precision, width, flags);
-#if defined(PRINTF_SUPPORT_LONG_LONG)
-        }
+size_t printf_kernel_ftoa32(char* buffer, size_t idx, size_t maxlen, float value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+#if defined(PRINTF_SUPPORT_FLOAT32)
+  union {
+    uint32_t U;
+    float    F;
+  } conv;
+  conv.F = value;
+  return _ftoa32(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, conv.U, prec, width, flags);
+#else
+  return _ftoa(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, (double)value, prec, width, flags);
 #endif
-        format++;
-        break;
-      }
+}
 
-      case '%' :
-        out('%', buffer, idx++, maxlen);
-        format++;
-        break;
 
-      default :
-        out(*format, buffer, idx++, maxlen);
-        format++;
-        break;
-    }
-  }
+#if defined(PRINTF_SUPPORT_EXPONENTIAL)
+size_t printf_kernel_etoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _etoa(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, prec, width, flags);
+}
+#endif
 
-  // termination
-  out((char)0, buffer, idx < maxlen ? idx : maxlen - 1U, maxlen);
 
-  // return written chars without terminating \0
-  return (int)idx;
+#if defined(PRINTF_SUPPORT_ROUNDTRIP)
+size_t printf_kernel_rtoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int width, unsigned int flags)
+{
+  return _rtoa(buffer ? _out_buffer : _out_null, buffer, idx, maxlen, value, width, flags);
 }
+#endif
+#endif  // PRINTF_SUPPORT_FLOAT
 
 
-///////////////////////////////////////////////////////////////////////////////
+#if defined(PRINTF_SUPPORT_BINARY)
+int binprintf(void* record, size_t count, const char* format, ...)
+{
+  va_list va;
+  va_start(va, format);
+  const int ret = _binprintf(_out_buffer, (char*)record, count, (uintptr_t)format, format, va);
+  va_end(va);
+  return ret;
+}
 
-int printf_(const char* format, ...)
+
+int fctbinprintf(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...)
 {
   va_list va;
   va_start(va, format);
-  char buffer[1];
-  const int ret = _vsnprintf(_out_char, buffer, (size_t)-1, format, va);
+  const out_span_wrap_type out_span_wrap = { out, arg };
+  const int ret = _binprintf(_out_fct_span, (char*)(uintptr_t)&out_span_wrap, (size_t)-1, (uintptr_t)format, format, va);
   va_end(va);
   return ret;
 }
 
 
-int sprintf_(char* buffer, const char* format, ...)
+#if defined(__GNUC__) && defined(__ELF__)
+int binprintf_id(void* record, size_t count, const char* format, ...)
 {
   va_list va;
   va_start(va, format);
-  const int ret = _vsnprintf(_out_buffer, buffer, (size_t)-1, format, va);
+  const int ret = _binprintf(_out_buffer, (char*)record, count, (uintptr_t)(format - __start_printf_formats), format, va);
   va_end(va);
   return ret;
 }
 
 
-int snprintf_(char* buffer, size_t count, const char* format, ...)
+int fctbinprintf_id(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...)
 {
   va_list va;
   va_start(va, format);
-  const int ret = _vsnprintf(_out_buffer, buffer, count, format, va);
+  const out_span_wrap_type out_span_wrap = { out, arg };
+  const int ret = _binprintf(_out_fct_span, (char*)(uintptr_t)&out_span_wrap, (size_t)-1, (uintptr_t)(format - __start_printf_formats), format, va);
   va_end(va);
   return ret;
 }
+#endif
 
 
-int vprintf_(const char* format, va_list va)
+size_t binheader(const void* record, size_t size, uintptr_t* key)
 {
-  char buffer[1];
-  return _vsnprintf(_out_char, buffer, (size_t)-1, format, va);
+  arg_type args;
+  args.array     = NULL;
+  args.array_end = NULL;
+  args.data      = (const unsigned char*)record;
+  args.end       = args.data + size;
+  *key = (uintptr_t)_bin_read(&args);
+  return (size_t)(args.data - (const unsigned char*)record);
 }
 
 
-int vsnprintf_(char* buffer, size_t count, const char* format, va_list va)
+int binsnprintf(char* buffer, size_t count, const char* format, const void* args, size_t size)
 {
-  return _vsnprintf(_out_buffer, buffer, count, format, va);
+  arg_type bin_args;
+  bin_args.array     = NULL;
+  bin_args.array_end = NULL;
+  bin_args.data      = (const unsigned char*)args;
+  bin_args.end       = bin_args.data + size;
+  return _format(_out_buffer, buffer, count, format, &bin_args);
 }
+#endif  // PRINTF_SUPPORT_BINARY
 
 
-int fctprintf(void (*out)(char character, void* arg), void* arg, const char* format, ...)
+#if defined(PRINTF_SUPPORT_RING)
+// a record in the ring is a 32-bit header word followed by the characters, padded to the next header word
+// the header is 0 until the record is committed, then the number of characters + 1. Consumed records are
+// cleared again, so a header word which was reserved but not yet committed reads 0, too.
+#define RING_HEADER_SIZE  4U
+
+// internal size of the record of 'len' characters in the ring
+static inline size_t _ring_record_size(size_t len)
+{
+  return RING_HEADER_SIZE + ((len + RING_HEADER_SIZE - 1U) & ~(size_t)(RING_HEADER_SIZE - 1U));
+}
+
+
+// internal header word of the record at 'pos'
+static inline uint32_t* _ring_header(const printf_ring_type* ring, size_t pos)
+{
+  return (uint32_t*)(void*)(ring->data + (pos & (ring->size - 1U)));
+}
+
+
+// wrapper (used as buffer) for the ring output: the characters of the record reserved at 'pos'
+typedef struct {
+  char*  data;
+  size_t mask;
+  size_t pos;
+} out_ring_wrap_type;
+
+
+// internal ring output, the characters are placed behind the header of the reserved record, wrapping
+// around the end of the ring storage. 'maxlen' is the reserved length, the termination is not stored.
+static void _out_ring(const char* data, size_t len, void* buffer, size_t idx, size_t maxlen)
+{
+  const out_ring_wrap_type* ring = (const out_ring_wrap_type*)buffer;
+  if (!data || (idx >= maxlen)) {
+    return;
+  }
+  if (len > maxlen - idx) {
+    len = maxlen - idx;
+  }
+  size_t pos = ring->pos + RING_HEADER_SIZE + idx;
+  while (len--) {
+    ring->data[pos++ & ring->mask] = *data++;
+  }
+}
+
+
+int printf_ring_init(printf_ring_type* ring, void* storage, size_t size)
+{
+  if ((size < 2U * RING_HEADER_SIZE) || (size & (size - 1U)) || ((uintptr_t)storage & (RING_HEADER_SIZE - 1U))) {
+    return -1;
+  }
+  ring->data    = (char*)storage;
+  ring->size    = size;
+  ring->head    = 0U;
+  ring->tail    = 0U;
+  ring->dropped = 0U;
+  for (size_t i = 0U; i < size; ++i) {
+    ring->data[i] = 0;
+  }
+  return 0;
+}
+
+
+int printf_ring(printf_ring_type* ring, const char* format, ...)
 {
   va_list va;
   va_start(va, format);
-  const out_fct_wrap_type out_fct_wrap = { out, arg };
-  const int ret = _vsnprintf(_out_fct, (char*)(uintptr_t)&out_fct_wrap, (size_t)-1, format, va);
+  const int ret = vprintf_ring(ring, format, va);
   va_end(va);
   return ret;
 }
+
+
+int vprintf_ring(printf_ring_type* ring, const char* format, va_list va)
+{
+  // measure, so exactly the size of the record is reserved
+  va_list measure_va;
+  va_copy(measure_va, va);
+  const int len = vprintf_measure(format, measure_va);
+  va_end(measure_va);
+  const size_t size = _ring_record_size((size_t)len);
+  if ((len < 0) || ((size_t)len >= (uint32_t)-1) || (size > ring->size)) {
+    __atomic_fetch_add(&ring->dropped, 1U, __ATOMIC_RELAXED);
+    return -1;
+  }
+
+  // reserve, the record is dropped instead of waiting for the consumer if the ring is full
+  size_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+  do {
+    const size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (size > ring->size - (head - tail)) {
+      __atomic_fetch_add(&ring->dropped, 1U, __ATOMIC_RELAXED);
+      return -1;
+    }
+  } while (!__atomic_compare_exchange_n(&ring->head, &head, head + size, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+  // format into the reserved record and commit it
+  const out_ring_wrap_type out_ring_wrap = { ring->data, ring->size - 1U, head };
+  _vsnprintf(_out_ring, (char*)(uintptr_t)&out_ring_wrap, (size_t)len, format, va);
+  __atomic_store_n(_ring_header(ring, head), (uint32_t)len + 1U, __ATOMIC_RELEASE);
+  return len;
+}
+
+
+int printf_ring_read(printf_ring_type* ring, char* line, size_t count)
+{
+  const size_t   tail   = ring->tail;
+  uint32_t*      header = _ring_header(ring, tail);
+  const uint32_t commit = __atomic_load_n(header, __ATOMIC_ACQUIRE);
+  if (!commit) {
+    return -1;
+  }
+
+  // copy the characters out and clear the record for the next round through the ring
+  const size_t len  = (size_t)commit - 1U;
+  const size_t size = _ring_record_size(len);
+  const size_t mask = ring->size - 1U;
+  for (size_t i = 0U; i < len; ++i) {
+    const size_t pos = (tail + RING_HEADER_SIZE + i) & mask;
+    if (i + 1U < count) {
+      line[i] = ring->data[pos];
+    }
+  }
+  if (count) {
+    line[len < count ? len : count - 1U] = 0;
+  }
+  // a header of the next round may land on any word of this record and producers access headers atomically,
+  // so clear word by word with atomic stores, the release of the tail publishes the cleared words
+  for (size_t i = 0U; i < size; i += RING_HEADER_SIZE) {
+    __atomic_store_n(_ring_header(ring, tail + i), 0U, __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&ring->tail, tail + size, __ATOMIC_RELEASE);
+  return (int)len;
+}
+#endif  // PRINTF_SUPPORT_RING
@@ -34,6 +34,7 @@
 
 #include <stdarg.h>
 #include <stddef.h>
+#include <stdint.h>
 
 
 #ifdef __cplusplus
@@ -49,6 +50,25 @@ extern "C" {
 void _putchar(char character);
 
 
+/**
+ * Output a block of characters to a custom device like UART, used by the printf() function instead of
+ * _putchar() when PRINTF_SUPPORT_PUTCHARS is defined
+ * This function is declared here only. You have to write your custom implementation somewhere
+ * \param data Characters to output
+ * \param len Number of characters to output
+ */
+void _putchars(const char* data, size_t len);
+
+
+/**
+ * Number of characters _putchar() (or _putchars()) can take right now without blocking, e.g. the free space
+ * of a UART FIFO, used by try_printf() when PRINTF_SUPPORT_TRY_PRINTF is defined
+ * This function is declared here only. You have to write your custom implementation somewhere
+ * \return The number of characters the console can take without blocking
+ */
+size_t _putchar_room(void);
+
+
 /**
  * Tiny printf implementation
  * You have to implement _putchar if you use printf()
@@ -88,6 +108,20 @@ int  snprintf_(char* buffer, size_t count, const char* format, ...);
 int vsnprintf_(char* buffer, size_t count, const char* format, va_list va);
 
 
+/**
+ * sprintf/vsprintf variant for buffers which are known to be big enough, e.g. by a worst case of the format
+ * The output is written without a bounds check per character (like sprintf_()). With PRINTF_SPRINTF_SIZED_CHECK
+ * defined, the output is measured once per call and asserted to fit into 'size', otherwise 'size' is ignored.
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param size The size of the buffer, which MUST hold the output including the terminating null character
+ * \param format A string that specifies the format of the output
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters that are WRITTEN into the buffer, not counting the terminating null character
+ */
+int  sprintf_sized(char* buffer, size_t size, const char* format, ...);
+int vsprintf_sized(char* buffer, size_t size, const char* format, va_list va);
+
+
 /**
  * Tiny vprintf implementation
  * \param format A string that specifies the format of the output
@@ -98,6 +132,50 @@ int vsnprintf_(char* buffer, size_t count, const char* format, va_list va);
 int vprintf_(const char* format, va_list va);
 
 
+/**
+ * Non-blocking printf/vprintf, for PRINTF_SUPPORT_TRY_PRINTF
+ * The formatted length is measured first and checked against _putchar_room(), a line which doesn't fit is
+ * dropped instead of waiting for the console. The number of dropped lines is reported in front of the next
+ * line that fits (PRINTF_TRY_DROPPED_FORMAT, "[3 dropped]\n"), the report has to fit together with that line.
+ * The drop count is updated atomically with GCC and clang, so a caller which preempts another one neither loses
+ * drops nor reports them twice. The lines themselves go to _putchar(), which has to cope with such callers.
+ * \param format A string that specifies the format of the output
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters of the line that are written, not counting the drop report,
+ *         -1 if the line was dropped
+ */
+int  try_printf(const char* format, ...);
+int try_vprintf(const char* format, va_list va);
+
+
+/**
+ * snprintf/vsnprintf variant which stops parsing and converting as soon as the buffer is full
+ * The time spent is bounded by the buffer size (and the format), not by the arguments: a long %s argument
+ * is only scanned as far as it can be written. Use it where the full length of a truncated output is not needed.
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A string that specifies the format of the output
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters written into the buffer, not counting the terminating null character,
+ *         -1 if the output was truncated. The buffer is null terminated in both cases (if count is not 0).
+ */
+int  snprintf_trunc(char* buffer, size_t count, const char* format, ...);
+int vsnprintf_trunc(char* buffer, size_t count, const char* format, va_list va);
+
+
+/**
+ * Length of the formatted output, like snprintf(NULL, 0, ...) returns it
+ * The length is computed from the arguments without converting them, only %e, %g, the shortest round-trip
+ * %r and %R, the fixed point %k and %K (and %f of non finite values) are still converted, into a discarding
+ * output
+ * \param format A string that specifies the format of the output
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters that would be written, not counting the terminating null character
+ */
+int  printf_measure(const char* format, ...);
+int vprintf_measure(const char* format, va_list va);
+
+
 /**
  * printf with output function
  * You may use this as dynamic alternative to printf() with its fixed _putchar() output
@@ -109,6 +187,305 @@ int vprintf_(const char* format, va_list va);
 int fctprintf(void (*out)(char character, void* arg), void* arg, const char* format, ...);
 
 
+/**
+ * printf with block output function
+ * Like fctprintf(), but the output function receives whole spans of characters (literal runs,
+ * converted numbers, strings and padding) instead of being called once per character
+ * \param out An output function which takes a pointer to the characters, their count and an argument pointer
+ * \param arg An argument pointer for user data passed to output function
+ * \param format A string that specifies the format of the output
+ * \return The number of characters that are sent to the output function, not counting the terminating null character
+ */
+int fctprintf_span(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...);
+
+
+
+/**
+ * Pre-parsed format strings
+ * printf_compile() parses a format string once into a list of operations, each a literal text span followed by
+ * a conversion specifier. Formatting from that handle skips all format parsing. The handle is a plain array,
+ * so it can be placed in static storage, and it references the literal text of the format string, so the
+ * format string must outlive it.
+ */
+typedef struct {
+  unsigned int flags;       // internal flags
+  unsigned int width;
+  unsigned int precision;
+  unsigned int fbits;       // fraction bits of the fixed point types k and K
+  char         type;        // conversion type, 0 if there is no conversion
+} printf_spec_type;
+
+typedef struct {
+  const char*      text;    // literal text in front of the conversion
+  size_t           len;
+  printf_spec_type spec;
+} printf_op_type;
+
+
+/**
+ * Argument of an argument array, used instead of a va_list by snprintf_args() and snprintf_typed()
+ * An argument of another type than the specifier expects is converted (e.g. integer to double), strings read as 0
+ * for numeric specifiers (%p prints their address) and missing arguments read as 0 or "". Without length modifier,
+ * an integer argument is converted with the width its value needs, so it is never truncated to int.
+ */
+typedef enum {
+  PRINTF_ARG_NONE = 0,
+  PRINTF_ARG_INT,           // value.i, for d i c and * width/precision
+  PRINTF_ARG_UINT,          // value.u, for u x X o b
+  PRINTF_ARG_DOUBLE,        // value.d, for f F e E g G
+  PRINTF_ARG_STRING,        // value.s, for s
+  PRINTF_ARG_POINTER        // value.p, for p
+} printf_arg_tag_type;
+
+typedef struct {
+  printf_arg_tag_type tag;
+  union {
+    long long          i;
+    unsigned long long u;
+    double             d;
+    const char*        s;
+    const void*        p;
+  } value;
+} printf_arg_type;
+
+
+/**
+ * Parse a format string into a pre-parsed format handle
+ * \param ops A pointer to the operation array of the handle
+ * \param count The number of operations the array can hold, one per conversion plus one
+ * \param format A string that specifies the format of the output, it must outlive the handle
+ * \return The number of operations the format needs. A value larger than count indicates the array is too small,
+ *         the handle then outputs nothing.
+ */
+int printf_compile(printf_op_type* ops, size_t count, const char* format);
+
+
+/**
+ * snprintf/vsnprintf with a pre-parsed format handle
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A format handle, filled by printf_compile()
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+int  snprintf_compiled(char* buffer, size_t count, const printf_op_type* format, ...);
+int vsnprintf_compiled(char* buffer, size_t count, const printf_op_type* format, va_list va);
+
+
+/**
+ * snprintf with a pre-parsed format handle and an argument array
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A format handle, filled by printf_compile()
+ * \param args The arguments
+ * \param nargs The number of arguments
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+int snprintf_args(char* buffer, size_t count, const printf_op_type* format, const printf_arg_type* args, size_t nargs);
+
+
+/**
+ * snprintf with an argument array instead of a va_list, see tiny::snformat() in printf.hpp for C++
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A string that specifies the format of the output
+ * \param args The arguments
+ * \param nargs The number of arguments
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+int snprintf_typed(char* buffer, size_t count, const char* format, const printf_arg_type* args, size_t nargs);
+
+
+/**
+ * Resumable formatting, for output in slices through a sink which may be full (e.g. a UART TX FIFO)
+ * printf_resume() writes until the output function takes less than it is offered and returns, the state
+ * continues exactly there on the next call: a conversion the sink interrupted is converted again and the
+ * characters already taken are skipped, so nothing is lost or duplicated.
+ * The arguments come from an argument array or a binary record, which stay valid between the calls
+ * (e.g. from a periodic task). A va_list is only valid as long as the function which received it has not
+ * returned, so vprintf_resume_init() is for resuming within that function.
+ */
+typedef struct {
+  const char*            format;    // next literal run or conversion
+  size_t                 skip;      // characters of an interrupted conversion which are already written
+  size_t                 idx;       // characters written in total
+  const printf_arg_type* array;     // argument array, NULL when not used
+  const printf_arg_type* array_end;
+  const void*            data;      // binary record arguments, NULL when not used
+  const void*            end;
+  int                    has_va;    // the arguments come from 'va'
+  va_list                va;
+} printf_resume_type;
+
+
+/**
+ * Initialize a resumable formatting
+ * \param state The state to initialize
+ * \param format A string that specifies the format of the output, it must stay valid until the output is complete
+ * \param args The arguments, see snprintf_typed(), they must stay valid until the output is complete
+ * \param nargs The number of arguments
+ * \param va A value identifying a variable arguments list, see above
+ */
+void  printf_resume_init(printf_resume_type* state, const char* format, const printf_arg_type* args, size_t nargs);
+void vprintf_resume_init(printf_resume_type* state, const char* format, va_list va);
+
+
+/**
+ * Initialize a resumable formatting of the arguments of a binary record, see binsnprintf()
+ * \param state The state to initialize
+ * \param format The format string the record was encoded with
+ * \param args A pointer to the encoded arguments (behind the record header), valid until the output is complete
+ * \param size The size of the encoded arguments in bytes
+ */
+void printf_resume_init_binary(printf_resume_type* state, const char* format, const void* args, size_t size);
+
+
+/**
+ * Continue a resumable formatting
+ * \param state The state, initialized by one of the printf_resume_init() functions
+ * \param out An output function which takes a pointer to the characters, their count and an argument pointer.
+ *            It returns the number of characters it took, less than 'len' when it is full.
+ * \param arg An argument pointer for user data passed to output function
+ * \return 1 if the output function was full and printf_resume() has to be called again, 0 when the output is
+ *         complete. state->idx is the number of characters written so far.
+ */
+int printf_resume(printf_resume_type* state, size_t (*out)(const char* data, size_t len, void* arg), void* arg);
+
+
+/**
+ * Conversion kernels, used by the compile time C++ front end in printf.hpp
+ * Each converts one value into 'buffer' at 'idx' without any format parsing, nothing is written if buffer is
+ * NULL. 'flags' are the internal format flags.
+ * \return The index behind the converted value
+ */
+size_t printf_kernel_ntoa_long(char* buffer, size_t idx, size_t maxlen, unsigned long value, int negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_ntoa_long_long(char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned int base, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_qtoa(char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned int bits, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_ftoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_ftoa32(char* buffer, size_t idx, size_t maxlen, float value, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_etoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_kernel_rtoa(char* buffer, size_t idx, size_t maxlen, double value, unsigned int width, unsigned int flags);
+
+
+/**
+ * Deferred (binary) logging
+ * Instead of formatting, only the format string is walked to classify the arguments. The format string
+ * address and the raw argument values are stored in a compact record, which is formatted later on the host
+ * by binsnprintf(). Integers are LEB128 (signed ones zigzag) encoded, floating point values are stored as
+ * 8 byte little endian IEEE-754 doubles and strings are stored inline including their terminating NUL.
+ * Records are not self-delimiting, the transport has to frame them.
+ * \param record A pointer to the buffer where to store the record, may be NULL to get the record size only
+ * \param count The maximum number of bytes to store in the record buffer
+ * \param format A string that specifies the format of the output, it must stay at the same address
+ * \return The number of bytes that COULD have been written into the record buffer. A value larger than
+ *         count indicates truncation.
+ */
+int binprintf(void* record, size_t count, const char* format, ...);
+
+
+/**
+ * Deferred (binary) logging with block output function
+ * \param out An output function which takes a pointer to the record bytes, their count and an argument pointer
+ * \param arg An argument pointer for user data passed to output function
+ * \param format A string that specifies the format of the output, it must stay at the same address
+ * \return The number of record bytes that are sent to the output function
+ */
+int fctbinprintf(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...);
+
+
+/**
+ * Format string dictionary for deferred (binary) logging, GCC/clang on ELF targets only
+ * PRINTF_FORMAT() places a literal format string in the "printf_formats" section. BINPRINTF() and FCTBINPRINTF()
+ * wrap binprintf() and fctbinprintf(), but the record key is the offset of the format string in that section
+ * (a 16-bit ID as long as the section stays below 64 KiB) instead of its address. So format strings never go
+ * over the wire. The host tool tools/printf_dict extracts the section from the firmware image, the offset of
+ * each string is its ID.
+ */
+#if defined(__GNUC__) && defined(__ELF__)
+extern const char __start_printf_formats[] __attribute__((weak));   // provided by the linker
+#define PRINTF_FORMAT(format) \
+  (__extension__({ static const char printf_format_[] __attribute__((section("printf_formats"), aligned(1))) = format; printf_format_; }))
+#define BINPRINTF(record, count, format, ...)  binprintf_id(record, count, PRINTF_FORMAT(format), ##__VA_ARGS__)
+#define FCTBINPRINTF(out, arg, format, ...)   fctbinprintf_id(out, arg, PRINTF_FORMAT(format), ##__VA_ARGS__)
+int binprintf_id(void* record, size_t count, const char* format, ...);
+int fctbinprintf_id(void (*out)(const char* data, size_t len, void* arg), void* arg, const char* format, ...);
+#endif
+
+
+/**
+ * Read the header of a binary record
+ * \param record A pointer to the record
+ * \param size The size of the record in bytes
+ * \param key Receives the format string address (or dictionary ID) the record was encoded with
+ * \return The size of the header, the encoded arguments follow it
+ */
+size_t binheader(const void* record, size_t size, uintptr_t* key);
+
+
+/**
+ * Format the arguments of a binary record, like snprintf() does with the original arguments
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format The format string the record was encoded with (looked up from the record key)
+ * \param args A pointer to the encoded arguments (behind the record header)
+ * \param size The size of the encoded arguments in bytes
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+int binsnprintf(char* buffer, size_t count, const char* format, const void* args, size_t size);
+
+
+/**
+ * Lock-free multi-producer, single consumer ring buffer of formatted lines (GCC/clang __atomic builtins)
+ * A producer measures the formatted length, atomically reserves exactly that record in the ring, formats
+ * directly into it and commits it. So lines of concurrent producers (tasks, threads, interrupts) are never
+ * interleaved and producers never block: a line which doesn't fit is dropped and counted. The consumer reads
+ * the committed lines in reservation order, a reserved but not yet committed line holds back the ones behind it.
+ */
+typedef struct {
+  char*  data;              // ring storage
+  size_t size;              // size of the storage, a power of 2
+  size_t head;              // bytes reserved by the producers (free running)
+  size_t tail;              // bytes released by the consumer (free running)
+  size_t dropped;           // lines which didn't fit into the ring
+} printf_ring_type;
+
+
+/**
+ * Initialize a ring buffer
+ * \param ring The ring to initialize
+ * \param storage The ring storage, 4 byte aligned. Each line takes 4 bytes plus its length rounded up to 4.
+ * \param size The size of the storage in bytes, a power of 2 of at least 8
+ * \return 0 on success, -1 if the size or the alignment of the storage is not supported
+ */
+int printf_ring_init(printf_ring_type* ring, void* storage, size_t size);
+
+
+/**
+ * printf/vprintf into a ring buffer, safe to call concurrently from any number of producers
+ * \param ring The ring to write into
+ * \param format A string that specifies the format of the output
+ * \param va A value identifying a variable arguments list
+ * \return The number of characters written into the ring, -1 if the line was dropped as the ring is full
+ */
+int  printf_ring(printf_ring_type* ring, const char* format, ...);
+int vprintf_ring(printf_ring_type* ring, const char* format, va_list va);
+
+
+/**
+ * Read the next committed line from a ring buffer, from a single consumer only
+ * \param ring The ring to read from
+ * \param line A pointer to the buffer where to store the line
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \return The length of the line, not counting the terminating null character (the line is truncated if it is
+ *         count or more), -1 if there is no committed line
+ */
+int printf_ring_read(printf_ring_type* ring, char* line, size_t count);
+
+
 #ifdef __cplusplus
 }
 #endif
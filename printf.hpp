@@ -0,0 +1,591 @@
+///////////////////////////////////////////////////////////////////////////////
+// \author (c) Marco Paland (info@paland.com)
+//             2014-2019, PALANDesign Hannover, Germany
+//
+// \license The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// \brief Compile time format front end, header-only, C++17.
+//        The format string is parsed by constexpr functions, formatting is a
+//        fixed sequence of calls into the conversion kernels of printf.c, with
+//        no format parsing and no va_arg at runtime. Invalid specifiers and
+//        argument count or type mismatches fail compilation.
+//        tiny::snformat() is the type safe counterpart for runtime format
+//        strings, it passes a typed argument array instead of a va_list.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PRINTF_HPP_
+#define _PRINTF_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "printf.h"
+
+
+/**
+ * Compile time formatted output to a buffer, a string literal can't be a template argument in C++17,
+ * so the macro places it in a static constexpr array first
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param literal A string literal that specifies the format of the output
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+#define TINY_FORMAT(buffer, count, literal, ...) \
+  ([&]() { static constexpr char tiny_format_[] = literal; return tiny::format<tiny_format_>(buffer, count, ##__VA_ARGS__); }())
+
+
+namespace tiny {
+
+namespace detail {
+
+// format flags, these must match the internal FLAGS_ definitions of printf.c
+constexpr unsigned int flag_zeropad       = 1U <<  0U;
+constexpr unsigned int flag_left          = 1U <<  1U;
+constexpr unsigned int flag_plus          = 1U <<  2U;
+constexpr unsigned int flag_space         = 1U <<  3U;
+constexpr unsigned int flag_hash          = 1U <<  4U;
+constexpr unsigned int flag_uppercase     = 1U <<  5U;
+constexpr unsigned int flag_char          = 1U <<  6U;
+constexpr unsigned int flag_short         = 1U <<  7U;
+constexpr unsigned int flag_long          = 1U <<  8U;
+constexpr unsigned int flag_long_long     = 1U <<  9U;
+constexpr unsigned int flag_precision     = 1U << 10U;
+constexpr unsigned int flag_adapt_exp     = 1U << 11U;
+constexpr unsigned int flag_width_arg     = 1U << 12U;
+constexpr unsigned int flag_precision_arg = 1U << 13U;
+
+
+// not constexpr, so reaching it during the constant evaluation of the format parser is a compile error
+inline void invalid_format_specifier() { }
+
+
+// one operation: a literal text span of the format followed by an optional conversion
+struct op_type {
+  std::size_t  text;        // offset of the literal text in the format string
+  std::size_t  len;         // length of the literal text
+  unsigned int flags;
+  unsigned int width;
+  unsigned int precision;
+  unsigned int fbits;       // fraction bits of the fixed point types k and K
+  char         type;        // 0 if the operation has no conversion
+};
+
+
+constexpr bool is_digit(char ch)
+{
+  return (ch >= '0') && (ch <= '9');
+}
+
+
+// parses one operation beginning at 'format[i]', like _parse_spec() of printf.c
+// \return The operation, 'i' is advanced behind it
+constexpr op_type parse_op(const char* format, std::size_t& i)
+{
+  op_type op { i, 0U, 0U, 0U, 0U, 0U, 0 };
+  while (format[i] && (format[i] != '%')) {
+    i++;
+  }
+  op.len = i - op.text;
+  if (!format[i]) {
+    return op;
+  }
+  i++;
+
+  // evaluate flags
+  unsigned int flags = 0U;
+  for (bool more = true; more; ) {
+    switch (format[i]) {
+      case '0': flags |= flag_zeropad; i++; break;
+      case '-': flags |= flag_left;    i++; break;
+      case '+': flags |= flag_plus;    i++; break;
+      case ' ': flags |= flag_space;   i++; break;
+      case '#': flags |= flag_hash;    i++; break;
+      default : more = false;                break;
+    }
+  }
+
+  // evaluate width field
+  if (is_digit(format[i])) {
+    while (is_digit(format[i])) {
+      op.width = op.width * 10U + (unsigned int)(format[i++] - '0');
+    }
+  }
+  else if (format[i] == '*') {
+    flags |= flag_width_arg;
+    i++;
+  }
+
+  // evaluate precision field
+  if (format[i] == '.') {
+    flags |= flag_precision;
+    i++;
+    if (is_digit(format[i])) {
+      while (is_digit(format[i])) {
+        op.precision = op.precision * 10U + (unsigned int)(format[i++] - '0');
+      }
+    }
+    else if (format[i] == '*') {
+      flags |= flag_precision_arg;
+      i++;
+    }
+  }
+
+  // evaluate length field
+  switch (format[i]) {
+    case 'l' :
+      flags |= flag_long;
+      if (format[++i] == 'l') {
+        flags |= flag_long_long;
+        i++;
+      }
+      break;
+    case 'h' :
+      flags |= flag_short;
+      if (format[++i] == 'h') {
+        flags |= flag_char;
+        i++;
+      }
+      break;
+    case 't' :
+      flags |= (sizeof(std::ptrdiff_t) == sizeof(long) ? flag_long : flag_long_long);
+      i++;
+      break;
+    case 'j' :
+      flags |= (sizeof(std::intmax_t) == sizeof(long) ? flag_long : flag_long_long);
+      i++;
+      break;
+    case 'z' :
+      flags |= (sizeof(std::size_t) == sizeof(long) ? flag_long : flag_long_long);
+      i++;
+      break;
+    default :
+      break;
+  }
+
+  // evaluate type
+  switch (format[i]) {
+    case 'd' :
+    case 'i' :
+    case 'k' :
+      flags &= ~flag_hash;
+      break;
+    case 'u' :
+    case 'K' :
+      flags &= ~(flag_hash | flag_plus | flag_space);
+      break;
+    case 'X' :
+    case 'x' :
+    case 'o' :
+    case 'b' :
+      flags &= ~(flag_plus | flag_space);
+      if (format[i] == 'X') {
+        flags |= flag_uppercase;
+      }
+      break;
+    case 'F' :
+    case 'E' :
+    case 'R' :
+      flags |= flag_uppercase;
+      break;
+    case 'G' :
+      flags |= flag_adapt_exp | flag_uppercase;
+      break;
+    case 'g' :
+      flags |= flag_adapt_exp;
+      break;
+    case 'f' :
+    case 'e' :
+    case 'r' :
+    case 'c' :
+    case 's' :
+    case '%' :
+      break;
+    case 'p' :
+      flags |= flag_zeropad | flag_uppercase;
+      break;
+    default :
+      // unknown type or dangling '%'
+      invalid_format_specifier();
+      break;
+  }
+
+  // ignore '0' flag when precision is given
+  switch (format[i]) {
+    case 'd' : case 'i' : case 'u' : case 'x' : case 'X' : case 'o' : case 'b' :
+      if (flags & flag_precision) {
+        flags &= ~flag_zeropad;
+      }
+      break;
+    default :
+      break;
+  }
+
+  op.flags = flags;
+  op.type  = format[i++];
+  if ((op.type == 'k') || (op.type == 'K')) {
+    // the number of fraction bits follows the fixed point type
+    while (is_digit(format[i])) {
+      op.fbits = op.fbits * 10U + (unsigned int)(format[i++] - '0');
+    }
+  }
+  return op;
+}
+
+
+// number of arguments an operation consumes
+constexpr std::size_t op_args(const op_type& op)
+{
+  return (op.type && (op.type != '%') ? 1U : 0U) + ((op.flags & flag_width_arg) ? 1U : 0U) + ((op.flags & flag_precision_arg) ? 1U : 0U);
+}
+
+
+// number of operations of a format, the last one is the trailing literal text
+constexpr std::size_t count_ops(const char* format)
+{
+  std::size_t n = 0U, i = 0U;
+  for (;;) {
+    n++;
+    if (!parse_op(format, i).type) {
+      return n;
+    }
+  }
+}
+
+
+template <std::size_t N>
+constexpr std::array<op_type, N> parse_ops(const char* format)
+{
+  std::array<op_type, N> ops {};
+  std::size_t i = 0U;
+  for (std::size_t n = 0U; n < N; ++n) {
+    ops[n] = parse_op(format, i);
+  }
+  return ops;
+}
+
+
+template <std::size_t N>
+constexpr std::size_t count_args(const std::array<op_type, N>& ops)
+{
+  std::size_t n = 0U;
+  for (std::size_t i = 0U; i < N; ++i) {
+    n += op_args(ops[i]);
+  }
+  return n;
+}
+
+
+// the parsed format, evaluated once per format string at compile time
+template <const char* Format>
+struct compiled {
+  static constexpr std::size_t count = count_ops(Format);
+  static constexpr std::array<op_type, count> ops = parse_ops<count>(Format);
+  static constexpr std::size_t args = count_args(ops);
+};
+
+
+// output state, writes are bounded by 'maxlen', 'idx' counts all characters
+struct writer_type {
+  char*       buffer;
+  std::size_t idx;
+  std::size_t maxlen;
+
+  void put(const char* data, std::size_t len)
+  {
+    if (buffer) {
+      for (std::size_t i = 0U; (i < len) && (idx + i < maxlen); ++i) {
+        buffer[idx + i] = data[i];
+      }
+    }
+    idx += len;
+  }
+
+  void spaces(std::size_t count)
+  {
+    if (buffer) {
+      for (std::size_t i = 0U; (i < count) && (idx + i < maxlen); ++i) {
+        buffer[idx + i] = ' ';
+      }
+    }
+    idx += count;
+  }
+};
+
+
+// star argument of width or precision
+template <typename T>
+inline int star_arg(const T& value)
+{
+  static_assert(std::is_integral<T>::value, "'*' width or precision expects an integer argument");
+  return (int)value;
+}
+
+
+// conversion of one argument, the operation is the I-th one of Format
+template <const char* Format, std::size_t I, typename T>
+inline void convert(writer_type& w, unsigned int flags, unsigned int width, unsigned int precision, const T& value)
+{
+  constexpr op_type op = compiled<Format>::ops[I];
+
+  if constexpr ((op.type == 'd') || (op.type == 'i')) {
+    static_assert(std::is_integral<T>::value, "%d/%i expects an integer argument");
+    if constexpr (op.flags & flag_long_long) {
+      static_assert(sizeof(T) <= sizeof(long long), "%lld argument is too large");
+      const long long v = (long long)value;
+      w.idx = printf_kernel_ntoa_long_long(w.buffer, w.idx, w.maxlen, v > 0 ? (unsigned long long)v : 0U - (unsigned long long)v, v < 0, 10U, precision, width, flags);
+    }
+    else if constexpr (op.flags & flag_long) {
+      static_assert(sizeof(T) <= sizeof(long), "%ld argument is too large, use %lld");
+      const long v = (long)value;
+      w.idx = printf_kernel_ntoa_long(w.buffer, w.idx, w.maxlen, v > 0 ? (unsigned long)v : 0U - (unsigned long)v, v < 0, 10U, precision, width, flags);
+    }
+    else {
+      static_assert(sizeof(T) <= sizeof(int), "%d argument is too large, use %ld or %lld");
+      const int v = (op.flags & flag_char) ? (char)value : (op.flags & flag_short) ? (short int)value : (int)value;
+      w.idx = printf_kernel_ntoa_long(w.buffer, w.idx, w.maxlen, v > 0 ? (unsigned int)v : 0U - (unsigned int)v, v < 0, 10U, precision, width, flags);
+    }
+  }
+  else if constexpr ((op.type == 'u') || (op.type == 'x') || (op.type == 'X') || (op.type == 'o') || (op.type == 'b')) {
+    static_assert(std::is_integral<T>::value, "%u/%x/%X/%o/%b expects an integer argument");
+    constexpr unsigned int base = ((op.type == 'x') || (op.type == 'X')) ? 16U : (op.type == 'o') ? 8U : (op.type == 'b') ? 2U : 10U;
+    if constexpr (op.flags & flag_long_long) {
+      static_assert(sizeof(T) <= sizeof(long long), "%llu argument is too large");
+      w.idx = printf_kernel_ntoa_long_long(w.buffer, w.idx, w.maxlen, (unsigned long long)value, 0, base, precision, width, flags);
+    }
+    else if constexpr (op.flags & flag_long) {
+      static_assert(sizeof(T) <= sizeof(long), "%lu argument is too large, use %llu");
+      w.idx = printf_kernel_ntoa_long(w.buffer, w.idx, w.maxlen, (unsigned long)value, 0, base, precision, width, flags);
+    }
+    else {
+      static_assert(sizeof(T) <= sizeof(int), "%u argument is too large, use %lu or %llu");
+      const unsigned int v = (op.flags & flag_char) ? (unsigned char)value : (op.flags & flag_short) ? (unsigned short int)value : (unsigned int)value;
+      w.idx = printf_kernel_ntoa_long(w.buffer, w.idx, w.maxlen, v, 0, base, precision, width, flags);
+    }
+  }
+  else if constexpr ((op.type == 'k') || (op.type == 'K')) {
+    static_assert(std::is_integral<T>::value, "%k/%K expects an integer argument");
+    static_assert(sizeof(T) <= ((op.flags & flag_long_long) ? sizeof(long long) : (op.flags & flag_long) ? sizeof(long) : sizeof(int)), "%k/%K argument is too large, use %lk or %llk");
+    if constexpr (op.type == 'k') {
+      const long long v = (op.flags & flag_char) ? (char)value : (op.flags & flag_short) ? (short int)value : (op.flags & flag_long_long) ? (long long)value : (op.flags & flag_long) ? (long)value : (int)value;
+      w.idx = printf_kernel_qtoa(w.buffer, w.idx, w.maxlen, v > 0 ? (unsigned long long)v : 0U - (unsigned long long)v, v < 0, op.fbits, precision, width, flags);
+    }
+    else {
+      const unsigned long long v = (op.flags & flag_char) ? (unsigned char)value : (op.flags & flag_short) ? (unsigned short int)value : (op.flags & flag_long_long) ? (unsigned long long)value : (op.flags & flag_long) ? (unsigned long)value : (unsigned int)value;
+      w.idx = printf_kernel_qtoa(w.buffer, w.idx, w.maxlen, v, 0, op.fbits, precision, width, flags);
+    }
+  }
+  else if constexpr ((op.type == 'f') || (op.type == 'F')) {
+    static_assert(std::is_floating_point<T>::value, "%f expects a floating point argument");
+    if constexpr (std::is_same<T, float>::value || (op.flags & flag_short)) {
+      // single precision, float arguments aren't promoted to double
+      w.idx = printf_kernel_ftoa32(w.buffer, w.idx, w.maxlen, (float)value, precision, width, flags);
+    }
+    else {
+      w.idx = printf_kernel_ftoa(w.buffer, w.idx, w.maxlen, (double)value, precision, width, flags);
+    }
+  }
+  else if constexpr ((op.type == 'e') || (op.type == 'E') || (op.type == 'g') || (op.type == 'G')) {
+    static_assert(std::is_floating_point<T>::value, "%e/%g expects a floating point argument");
+    w.idx = printf_kernel_etoa(w.buffer, w.idx, w.maxlen, (double)value, precision, width, flags);
+  }
+  else if constexpr ((op.type == 'r') || (op.type == 'R')) {
+    static_assert(std::is_floating_point<T>::value, "%r expects a floating point argument");
+    w.idx = printf_kernel_rtoa(w.buffer, w.idx, w.maxlen, (double)value, width, flags);
+  }
+  else if constexpr (op.type == 'c') {
+    static_assert(std::is_integral<T>::value, "%c expects a character argument");
+    const char c = (char)value;
+    if (!(flags & flag_left) && (width > 1U)) {
+      w.spaces(width - 1U);
+    }
+    w.put(&c, 1U);
+    if ((flags & flag_left) && (width > 1U)) {
+      w.spaces(width - 1U);
+    }
+  }
+  else if constexpr (op.type == 's') {
+    static_assert(std::is_convertible<const T&, const char*>::value, "%s expects a string argument");
+    const char* p = value;
+    if (!p) {
+      p = "(null)";
+    }
+    unsigned int l = 0U;
+    const unsigned int max = (flags & flag_precision) ? precision : ~0U;
+    while ((l < max) && p[l]) {
+      l++;
+    }
+    if (!(flags & flag_left) && (l < width)) {
+      w.spaces(width - l);
+    }
+    w.put(p, l);
+    if ((flags & flag_left) && (l < width)) {
+      w.spaces(width - l);
+    }
+  }
+  else if constexpr (op.type == 'p') {
+    static_assert(std::is_convertible<const T&, const volatile void*>::value, "%p expects a pointer argument");
+    const std::uintptr_t v = reinterpret_cast<std::uintptr_t>(static_cast<const volatile void*>(value));
+    if constexpr (sizeof(std::uintptr_t) == sizeof(long long)) {
+      w.idx = printf_kernel_ntoa_long_long(w.buffer, w.idx, w.maxlen, (unsigned long long)v, 0, 16U, precision, sizeof(void*) * 2U, flags);
+    }
+    else {
+      w.idx = printf_kernel_ntoa_long(w.buffer, w.idx, w.maxlen, (unsigned long)v, 0, 16U, precision, sizeof(void*) * 2U, flags);
+    }
+  }
+}
+
+
+// output of operation I and all following ones, A is the index of the next argument
+template <const char* Format, std::size_t I, std::size_t A, typename Tuple>
+inline void emit(writer_type& w, const Tuple& args)
+{
+  constexpr op_type op = compiled<Format>::ops[I];
+
+  if constexpr (op.len > 0U) {
+    w.put(Format + op.text, op.len);
+  }
+
+  if constexpr (op.type == '%') {
+    w.put("%", 1U);
+  }
+  else if constexpr (op.type != 0) {
+    constexpr std::size_t arg_precision = A + ((op.flags & flag_width_arg) ? 1U : 0U);
+    constexpr std::size_t arg_value     = arg_precision + ((op.flags & flag_precision_arg) ? 1U : 0U);
+    unsigned int flags     = op.flags;
+    unsigned int width     = op.width;
+    unsigned int precision = op.precision;
+    if constexpr (op.flags & flag_width_arg) {
+      const int v = star_arg(std::get<A>(args));
+      if (v < 0) {
+        flags |= flag_left;    // reverse padding
+        width = (unsigned int)-v;
+      }
+      else {
+        width = (unsigned int)v;
+      }
+    }
+    if constexpr (op.flags & flag_precision_arg) {
+      const int v = star_arg(std::get<arg_precision>(args));
+      precision = v > 0 ? (unsigned int)v : 0U;
+    }
+    convert<Format, I>(w, flags, width, precision, std::get<arg_value>(args));
+  }
+
+  if constexpr (op.type != 0) {
+    emit<Format, I + 1U, A + op_args(op)>(w, args);
+  }
+}
+
+}  // namespace detail
+
+
+/**
+ * Compile time formatted output to a buffer
+ * \param Format The format string, a static constexpr char array (see TINY_FORMAT())
+ * \param buffer A pointer to the buffer where to store the formatted string, may be NULL to get the length only
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param args The arguments, their count and types are checked at compile time
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+template <const char* Format, typename... Args>
+inline int format(char* buffer, std::size_t count, const Args&... args)
+{
+  static_assert(detail::compiled<Format>::args == sizeof...(Args), "argument count doesn't match the format string");
+
+  detail::writer_type w { buffer, 0U, buffer ? count : 0U };
+  detail::emit<Format, 0U, 0U>(w, std::forward_as_tuple(args...));
+
+  // termination
+  if (buffer && count) {
+    buffer[w.idx < count ? w.idx : count - 1U] = 0;
+  }
+  return (int)w.idx;
+}
+
+
+namespace detail {
+
+// packs one argument into a tagged argument, keeping its signedness and width
+template <typename T>
+inline printf_arg_type make_arg(const T& value)
+{
+  printf_arg_type arg {};
+  if constexpr (std::is_enum<T>::value) {
+    return make_arg(static_cast<typename std::underlying_type<T>::type>(value));
+  }
+  else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+    arg.tag     = PRINTF_ARG_INT;
+    arg.value.i = (long long)value;
+  }
+  else if constexpr (std::is_integral<T>::value) {
+    arg.tag     = PRINTF_ARG_UINT;
+    arg.value.u = (unsigned long long)value;
+  }
+  else if constexpr (std::is_floating_point<T>::value) {
+    arg.tag     = PRINTF_ARG_DOUBLE;
+    arg.value.d = (double)value;
+  }
+  else if constexpr (std::is_convertible<const T&, const char*>::value) {
+    arg.tag     = PRINTF_ARG_STRING;
+    arg.value.s = value;
+  }
+  else {
+    static_assert(std::is_convertible<const T&, const volatile void*>::value, "argument type can't be formatted");
+    arg.tag     = PRINTF_ARG_POINTER;
+    arg.value.p = const_cast<const void*>(static_cast<const volatile void*>(value));
+  }
+  return arg;
+}
+
+}  // namespace detail
+
+
+/**
+ * Type safe formatted output to a buffer with a runtime format string
+ * The arguments are packed into a typed argument array instead of a va_list, so nothing is promoted and every
+ * specifier/argument mismatch has a defined result: the argument is converted to what the specifier expects,
+ * strings read as 0 for numeric specifiers (%p prints their address), other arguments read as "" for %s and
+ * missing arguments read as 0 or "". Without length modifier, integers are converted with their own width,
+ * e.g. "%d" prints a long long without truncation.
+ * \param buffer A pointer to the buffer where to store the formatted string, may be NULL to get the length only
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A string that specifies the format of the output
+ * \param args The arguments
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+template <typename... Args>
+inline int snformat(char* buffer, std::size_t count, const char* format, const Args&... args)
+{
+  // one extra element, so an empty argument list is no zero sized array
+  const printf_arg_type array[sizeof...(Args) + 1U] = { detail::make_arg(args)..., printf_arg_type {} };
+  return snprintf_typed(buffer, count, format, array, sizeof...(Args));
+}
+
+}  // namespace tiny
+
+#endif  // _PRINTF_HPP_
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// \author (c) Marco Paland (info@paland.com)
+//             2017-2019, PALANDesign Hannover, Germany
+//
+// \license The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// \brief printf benchmark, snprintf_() against the compile time front end on
+//        formats taken from the test suite. Build and run with 'make bench'.
+//        On Linux the instructions per snprintf_() call are counted, too, and
+//        snprintf_() is compared with the printf_() and fctprintf() output.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../printf.hpp"
+
+
+// printf.c expects it, the benchmark doesn't print through it
+void _putchar(char character)
+{
+  (void)character;
+}
+
+
+static const unsigned int ITERATIONS = 1000000U;
+
+// sink for the results, so the calls can't be optimized away
+static volatile int sink;
+
+
+// time 'ITERATIONS' calls of 'fn' in ns per call
+template <typename Fn>
+static double bench(Fn fn)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0U; i < ITERATIONS; ++i) {
+    sink = fn(i);
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / ITERATIONS;
+}
+
+
+// instructions per call of 'fn' in user space, counted by the Linux perf events of the CPU
+// \return -1 if there is no instruction counter (other OS, no PMU in a VM, perf_event_paranoid)
+template <typename Fn>
+static double instructions(Fn fn)
+{
+#if defined(__linux__)
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  const int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  if (fd < 0) {
+    return -1.0;
+  }
+  const unsigned int calls = ITERATIONS / 10U;
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  for (unsigned int i = 0U; i < calls; ++i) {
+    sink = fn(i);
+  }
+  ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  unsigned long long count = 0U;
+  const bool ok = read(fd, &count, sizeof(count)) == (ssize_t)sizeof(count);
+  close(fd);
+  return ok ? (double)count / calls : -1.0;
+#else
+  (void)fn;
+  return -1.0;
+#endif
+}
+
+
+// callback of fctprintf(), discards the output like _putchar()
+static void out_discard(char character, void* arg)
+{
+  (void)character;
+  (void)arg;
+}
+
+
+// runtime and compile time formatting of the same format and arguments, the
+// loop counter is passed through 'i' so the arguments aren't constant
+#define BENCH(format, ...) \
+  do { \
+    char buffer_[100]; \
+    const double runtime_      = bench([&](unsigned int i) { (void)i; return snprintf_(buffer_, sizeof(buffer_), format, __VA_ARGS__); }); \
+    const double compile_time_ = bench([&](unsigned int i) { (void)i; return TINY_FORMAT(buffer_, sizeof(buffer_), format, __VA_ARGS__); }); \
+    const double instr_        = instructions([&](unsigned int i) { (void)i; return snprintf_(buffer_, sizeof(buffer_), format, __VA_ARGS__); }); \
+    if (instr_ < 0.0) { \
+      fprintf(stdout, "%-34s %10.1f %10.1f %8.2fx %10s\n", format, runtime_, compile_time_, runtime_ / compile_time_, "-"); \
+    } \
+    else { \
+      fprintf(stdout, "%-34s %10.1f %10.1f %8.2fx %10.0f\n", format, runtime_, compile_time_, runtime_ / compile_time_, instr_); \
+    } \
+  } while (0)
+
+
+// the same format through the output functions of printf.c, see PRINTF_SPECIALIZE_OUTPUT
+#define BENCH_OUTPUT(format, ...) \
+  do { \
+    char buffer_[100]; \
+    const double snprintf_time_  = bench([&](unsigned int i) { (void)i; return snprintf_(buffer_, sizeof(buffer_), format, __VA_ARGS__); }); \
+    const double printf_time_    = bench([&](unsigned int i) { (void)i; return printf_(format, __VA_ARGS__); }); \
+    const double fctprintf_time_ = bench([&](unsigned int i) { (void)i; return fctprintf(&out_discard, nullptr, format, __VA_ARGS__); }); \
+    fprintf(stdout, "%-34s %10.1f %10.1f %10.1f\n", format, snprintf_time_, printf_time_, fctprintf_time_); \
+  } while (0)
+
+
+int main()
+{
+  fprintf(stdout, "%-34s %10s %10s %9s %10s\n", "format", "snprintf_", "tiny", "speedup", "snprintf_");
+  fprintf(stdout, "%-34s %10s %10s %9s %10s\n", "", "[ns/call]", "[ns/call]", "", "[instr]");
+
+  BENCH("% d", (int)i);
+  BENCH("%+d", (int)i);
+  BENCH("%-5d", -(int)i);
+  BENCH("%05d", (int)i);
+  BENCH("%u", i);
+  BENCH("%x", i);
+  BENCH("%#X", i);
+  BENCH("%#o", i);
+  BENCH("%b", i);
+  BENCH("%lld", (long long)i * 1000000007LL);
+  BENCH("%llx", (unsigned long long)i * 1000000007ULL);
+  BENCH("%llu", (unsigned long long)i * 18446744073ULL);
+  BENCH("%.3f", (double)i / 7.0);
+  BENCH("%10.4f", (double)i / 3.0);
+  BENCH("%.3hf", (float)i / 7.0f);
+  BENCH("%e", (double)i * 1.5e10);
+  BENCH("%g", (double)i / 9.0);
+  BENCH("%.17g", (double)i / 9.0);
+  BENCH("%r", (double)i / 9.0);
+  BENCH("%s", "Hello testing");
+  BENCH("%-10s|%10s", "left", "right");
+  BENCH("%c%c%c", 'a' + (int)(i & 7U), 'b', 'c');
+  BENCH("%*d", 10, (int)i);
+  BENCH("%.*f", 2, (double)i);
+  BENCH("x=%d y=%5.2f", (int)i, (double)i * 0.25);
+  BENCH("pressure=%d flow=%-6.2f state=%s", (int)i, -3.5, "INHALE");
+
+  fprintf(stdout, "\n%-34s %10s %10s %10s\n", "format", "snprintf_", "printf_", "fctprintf");
+  fprintf(stdout, "%-34s %10s %10s %10s\n", "", "[ns/call]", "[ns/call]", "[ns/call]");
+
+  BENCH_OUTPUT("%d", (int)i);
+  BENCH_OUTPUT("%-10s|%10s", "left", "right");
+  BENCH_OUTPUT("pressure=%d flow=%-6.2f state=%s", (int)i, -3.5, "INHALE");
+
+  return 0;
+}
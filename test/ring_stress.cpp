@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// \author (c) Marco Paland (info@paland.com)
+//             2017-2019, PALANDesign Hannover, Germany
+//
+// \license The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// \brief printf_ring() stress benchmark: N producer threads log into one ring
+//        concurrently, a consumer checks that every line arrives whole and in
+//        order per producer. A producer retries a line the full ring dropped.
+//        Build and run with 'make ring_stress', the producer count and the
+//        lines per producer are optional arguments.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include "../printf.h"
+
+
+// printf.c expects it, the stress benchmark doesn't print through it
+void _putchar(char character)
+{
+  (void)character;
+}
+
+
+static const size_t RING_SIZE = 4096U;
+
+
+int main(int argc, char* argv[])
+{
+  const unsigned int producers = (argc > 1) ? (unsigned int)atoi(argv[1]) : 4U;
+  const unsigned int lines     = (argc > 2) ? (unsigned int)atoi(argv[2]) : 200000U;
+
+  alignas(4) static char storage[RING_SIZE];
+  printf_ring_type ring;
+  printf_ring_init(&ring, storage, sizeof(storage));
+
+  std::atomic<unsigned int> running(producers);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int p = 0U; p < producers; ++p) {
+    threads.emplace_back([&ring, &running, p, lines]() {
+      for (unsigned int n = 0U; n < lines; ++n) {
+        // printf_ring() never blocks, the benchmark retries a dropped line to get all lines checked
+        while (printf_ring(&ring, "producer=%u line=%u check=%d flow=%.2f", p, n, (int)(n * 7U) - 3, (double)n * 0.25) < 0) {
+          std::this_thread::yield();
+        }
+      }
+      running.fetch_sub(1U);
+    });
+  }
+
+  // the consumer: every line must parse completely, the line numbers of each producer must follow each other
+  std::vector<long> last(producers, -1L);
+  unsigned long received = 0U, broken = 0U;
+  char line[100];
+  for (;;) {
+    const bool done = !running.load();
+    int len;
+    while ((len = printf_ring_read(&ring, line, sizeof(line))) >= 0) {
+      unsigned int p, n;
+      int check, end = 0;
+      double flow;
+      if ((sscanf(line, "producer=%u line=%u check=%d flow=%lf%n", &p, &n, &check, &flow, &end) != 4) || (end != len) ||
+          (p >= producers) || ((long)n != last[p] + 1L) || (check != (int)(n * 7U) - 3)) {
+        ++broken;
+        continue;
+      }
+      last[p] = (long)n;
+      ++received;
+    }
+    if (done) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  fprintf(stdout, "%u producers, %u lines each, %u byte ring\n", producers, lines, (unsigned int)RING_SIZE);
+  fprintf(stdout, "received %lu, broken %lu, ring full %lu times\n", received, broken, (unsigned long)ring.dropped);
+  fprintf(stdout, "%.1f ns per line, %.0f lines/s\n", elapsed.count() * 1e9 / ((double)producers * lines), (double)producers * lines / elapsed.count());
+  const bool ok = !broken && (received == (unsigned long)producers * lines);
+  fprintf(stdout, "%s\n", ok ? "OK" : "FAILED");
+  return ok ? 0 : 1;
+}
@@ -31,16 +31,31 @@
 #include "catch.hpp"
 
 #include <string.h>
+#include <stdlib.h>
 #include <sstream>
 #include <math.h>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 
 
 namespace test {
   // use functions in own test namespace to avoid stdio conflicts
   #include "../printf.h"
   #include "../printf.c"
+  #include "../printf.hpp"
 } // namespace test
 
+// TINY_FORMAT() refers to the compile time front end unqualified
+namespace tiny = test::tiny;
+
+#if defined(PRINTF_SUPPORT_BINARY)
+// format string dictionary functions of the host tool
+#define PRINTF_DICT_NO_MAIN
+#include "../tools/printf_dict.c"
+#endif
+
 
 // dummy putchar
 static char   printf_buffer[100];
@@ -51,12 +66,30 @@ void test::_putchar(char character)
   printf_buffer[printf_idx++] = character;
 }
 
+#if defined(PRINTF_SUPPORT_TRY_PRINTF)
+// console room of the dummy putchar
+static size_t printf_room = 0U;
+
+size_t test::_putchar_room(void)
+{
+  return printf_room;
+}
+#endif
+
 void _out_fct(char character, void* arg)
 {
   (void)arg;
   printf_buffer[printf_idx++] = character;
 }
 
+void _out_fct_span(const char* data, size_t len, void* arg)
+{
+  ++*(size_t*)arg;
+  while (len--) {
+    printf_buffer[printf_idx++] = *data++;
+  }
+}
+
 
 TEST_CASE("printf", "[]" ) {
   printf_idx = 0U;
@@ -68,12 +101,85 @@ TEST_CASE("printf", "[]" ) {
 }
 
 
+#if defined(PRINTF_SUPPORT_TRY_PRINTF)
+TEST_CASE("try_printf", "[]" ) {
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  printf_room = 5U;
+  REQUIRE(test::try_printf("%d\n", 1234) == 5);
+  REQUIRE(test::try_printf("%d\n", 12345) == -1);
+  printf_room = 10U;
+  REQUIRE(test::try_printf("%d\n", 123456789) == -1);
+  REQUIRE(printf_idx == 5U);
+
+  // the report of the two dropped lines doesn't fit in front of a short line, but in front of the next one
+  printf_room = 13U;
+  REQUIRE(test::try_printf("%s\n", "ok") == -1);
+  printf_room = 15U;
+  REQUIRE(test::try_printf("%s\n", "ok") == 3);
+  REQUIRE(!strncmp(printf_buffer, "1234\n[3 dropped]\nok\n", 20U));
+  REQUIRE(test::try_printf("%s\n", "ok") == 3);
+  REQUIRE(printf_idx == 23U);
+  printf_room = 0U;
+}
+#endif
+
+
 TEST_CASE("fctprintf", "[]" ) {
   printf_idx = 0U;
   memset(printf_buffer, 0xCC, 100U);
   test::fctprintf(&_out_fct, nullptr, "This is a test of %X", 0x12EFU);
   REQUIRE(!strncmp(printf_buffer, "This is a test of 12EF", 22U));
   REQUIRE(printf_buffer[22] == (char)0xCC);
+
+  // a NUL character is output, the end of the output is not
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  REQUIRE(test::fctprintf(&_out_fct, nullptr, "a%cb", 0) == 3);
+  REQUIRE(printf_idx == 3U);
+  REQUIRE(!memcmp(printf_buffer, "a\0b", 3U));
+  REQUIRE(printf_buffer[3] == (char)0xCC);
+}
+
+
+TEST_CASE("fctprintf_span", "[]" ) {
+  size_t calls = 0U;
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  REQUIRE(test::fctprintf_span(&_out_fct_span, &calls, "This is a test of %X", 0x12EFU) == 22);
+  REQUIRE(!strncmp(printf_buffer, "This is a test of 12EF", 22U));
+  REQUIRE(printf_buffer[22] == (char)0xCC);
+  REQUIRE(calls == 2U);
+
+  calls = 0U;
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  REQUIRE(test::fctprintf_span(&_out_fct_span, &calls, "[%-40s]%c", "padded", 'x') == 43);
+  REQUIRE(!strncmp(printf_buffer, "[padded                                  ]x", 43U));
+  REQUIRE(printf_buffer[43] == (char)0xCC);
+  REQUIRE(calls < 10U);
+}
+
+
+TEST_CASE("literal scan", "[]" ) {
+  alignas(16) char text[80];
+
+  for (size_t start = 0U; start < 16U; ++start) {
+    for (size_t end = start; end < 64U; ++end) {
+      memset(text, 'a', sizeof(text));
+      text[sizeof(text) - 1U] = 0;
+      text[end] = '%';
+      REQUIRE(test::_scan_literal_swar(&text[start]) == &text[end]);
+      REQUIRE(test::_scan_literal(&text[start]) == &text[end]);
+      text[end] = 0;
+      REQUIRE(test::_scan_literal_swar(&text[start]) == &text[end]);
+      REQUIRE(test::_scan_literal(&text[start]) == &text[end]);
+    }
+  }
+
+  char buffer[100];
+  test::sprintf(buffer, "pressure=%d flow=%d volume=%d%%\n", 12, -3, 456);
+  REQUIRE(!strcmp(buffer, "pressure=12 flow=-3 volume=456%\n"));
 }
 
 
@@ -134,6 +240,24 @@ TEST_CASE("vsnprintf", "[]" ) {
 }
 
 
+TEST_CASE("sprintf_sized", "[]" ) {
+  char buffer[100];
+
+  memset(buffer, 0xCC, sizeof(buffer));
+  REQUIRE(test::sprintf_sized(buffer, 18U, "%d %5s|%-4x|", -1000, "ab", 0xFU) == 17);
+  REQUIRE(!strcmp(buffer, "-1000    ab|f   |"));
+  REQUIRE(buffer[18] == (char)0xCC);
+
+  memset(buffer, 0xCC, sizeof(buffer));
+  REQUIRE(test::sprintf_sized(buffer, 40U, "%030.3f|%+08lld", -3.25, 42LL) == 39);
+  REQUIRE(!strcmp(buffer, "-0000000000000000000000003.250|+0000042"));
+  REQUIRE(buffer[40] == (char)0xCC);
+
+  REQUIRE(test::sprintf_sized(buffer, 1U, "%s", "") == 0);
+  REQUIRE(buffer[0] == 0);
+}
+
+
 TEST_CASE("space flag", "[]" ) {
   char buffer[100];
 
@@ -1120,15 +1244,12 @@ TEST_CASE("float", "[]" ) {
   test::sprintf(buffer, "%.10f", 42.895223);
   REQUIRE(!strcmp(buffer, "42.8952230000"));
 
-  // this testcase checks, that the precision is truncated to 9 digits.
-  // a perfect working float should return the whole number
+  // precisions above 9 are exact
   test::sprintf(buffer, "%.12f", 42.89522312345678);
-  REQUIRE(!strcmp(buffer, "42.895223123000"));
+  REQUIRE(!strcmp(buffer, "42.895223123457"));
 
-  // this testcase checks, that the precision is truncated AND rounded to 9 digits.
-  // a perfect working float should return the whole number
   test::sprintf(buffer, "%.12f", 42.89522387654321);
-  REQUIRE(!strcmp(buffer, "42.895223877000"));
+  REQUIRE(!strcmp(buffer, "42.895223876543"));
 
   test::sprintf(buffer, "%6.2f", 42.8952);
   REQUIRE(!strcmp(buffer, " 42.90"));
@@ -1202,15 +1323,25 @@ TEST_CASE("float", "[]" ) {
 
   test::sprintf(buffer, "%+.3E", 1.23e+308);
   REQUIRE(!strcmp(buffer, "+1.230E+308"));
+
+  // decade boundaries, subnormals and mantissas rounding up to 10
+  test::sprintf(buffer, "%e|%e|%e|%e", 1e22, 1e300, 1e-5, 9.9999e-100);
+  REQUIRE(!strcmp(buffer, "1.000000e+22|1.000000e+300|1.000000e-05|9.999900e-100"));
+  test::sprintf(buffer, "%e|%.3e|%e", 5e-324, 2.2250738585072014e-308, DBL_MAX);
+  REQUIRE(!strcmp(buffer, "4.940656e-324|2.225e-308|1.797693e+308"));
+  test::sprintf(buffer, "%e|%.0e|%.2E|%e", 9999999.7, 9.5, 99.999, 9.99999999e99);
+  REQUIRE(!strcmp(buffer, "1.000000e+07|1e+01|1.00E+02|1.000000e+100"));
 #endif
 
-  // out of range for float: should switch to exp notation if supported, else empty
+  // large values print every digit of the integer part
   test::sprintf(buffer, "%.1f", 1E20);
-#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
-  REQUIRE(!strcmp(buffer, "1.0e+20"));
-#else
-  REQUIRE(!strcmp(buffer, ""));
-#endif
+  REQUIRE(!strcmp(buffer, "100000000000000000000.0"));
+
+  char large[320];
+  test::sprintf(large, "%.0f", 1.7976931348623157e308);
+  REQUIRE(!strcmp(large, "1797693134862315708145274237317043567980705675258449965989174768031572607800285387605895586327668781715"
+                         "4045895351438246423432132688946418276846754670353751698604991057655128207624549009038932894407586850845"
+                         "5133942304583236903222948165808559332123348274797826204144723168738177180919299881250404026184124858368"));
 
   // brute force float
   bool fail = false;
@@ -1224,10 +1355,7 @@ TEST_CASE("float", "[]" ) {
   }
   REQUIRE(!fail);
 
-
-#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
-  // brute force exp
-  str.setf(std::ios::scientific, std::ios::floatfield);
+  // brute force large values
   for (float i = -1e20; i < 1e20; i += 1e15) {
     test::sprintf(buffer, "%.5f", i);
     str.str("");
@@ -1235,6 +1363,37 @@ TEST_CASE("float", "[]" ) {
     fail = fail || !!strcmp(buffer, str.str().c_str());
   }
   REQUIRE(!fail);
+
+  // exact digits beyond 9 fraction digits and for tiny values
+  test::sprintf(buffer, "%.20f", 0.1);
+  REQUIRE(!strcmp(buffer, "0.10000000000000000555"));
+  test::sprintf(buffer, "%.3f|%.30f", 1e-300, 1e-20);
+  REQUIRE(!strcmp(buffer, "0.000|0.000000000000000000010000000000"));
+  test::sprintf(buffer, "%.60f", 0.5);
+  REQUIRE(!strcmp(buffer, "0.500000000000000000000000000000000000000000000000000000000000"));
+  test::sprintf(buffer, "%.12f|%.2f|%.0f", 1234567890.123456789, 0.125, 2.5);
+  REQUIRE(!strcmp(buffer, "1234567890.123456716537|0.12|2"));
+  test::sprintf(buffer, "%.17f", 0.99999999999999999);
+  REQUIRE(!strcmp(buffer, "1.00000000000000000"));
+
+#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
+  // exact digits beyond double precision, exactly rounded ties and near ties
+  test::sprintf(buffer, "%.17g|%.16e|%.20e", 2844082176.0, 73.5, 10.5);
+  REQUIRE(!strcmp(buffer, "2.8440821760000000e+09|7.3500000000000000e+01|1.05000000000000000000e+01"));
+  test::sprintf(buffer, "%.2e|%.5e|%.12e|%.14e", 671.5, 5520245.0, 9.1261992560074992e-134, 87768.616161616155);
+  REQUIRE(!strcmp(buffer, "6.72e+02|5.52024e+06|9.126199256007e-134|8.77686161616162e+04"));
+
+  // 17 significant digits read back to the same value
+  uint64_t state = 88172645463325252ULL;
+  for (int i = 0; i < 20000; ++i) {
+    state ^= state << 13U; state ^= state >> 7U; state ^= state << 17U;
+    double d;
+    const uint64_t dbits = state & 0x7fefffffffffffffULL;
+    memcpy(&d, &dbits, sizeof(d));
+    test::sprintf(buffer, "%.17g", d);
+    const double r = strtod(buffer, nullptr);
+    REQUIRE(!memcmp(&r, &d, sizeof(d)));
+  }
 #endif
 }
 
@@ -1397,8 +1556,8 @@ TEST_CASE("pointer", "[]" ) {
 TEST_CASE("unknown flag", "[]" ) {
   char buffer[100];
 
-  test::sprintf(buffer, "%kmarco", 42, 37);
-  REQUIRE(!strcmp(buffer, "kmarco"));
+  test::sprintf(buffer, "%ymarco", 42, 37);
+  REQUIRE(!strcmp(buffer, "ymarco"));
 }
 
 
@@ -1479,6 +1638,618 @@ TEST_CASE("ret value", "[]" ) {
 }
 
 
+TEST_CASE("compiled format", "[]" ) {
+  static test::printf_op_type handle[4];
+  char buffer[100];
+
+  REQUIRE(test::printf_compile(handle, 4U, "pressure=%d flow=%-6.2f state=%s\n") == 4);
+  REQUIRE(test::snprintf_compiled(buffer, sizeof(buffer), handle, 12, -3.5, "INHALE") == 37);
+  REQUIRE(!strcmp(buffer, "pressure=12 flow=-3.50  state=INHALE\n"));
+  REQUIRE(test::snprintf_compiled(buffer, 10U, handle, 12, -3.5, "INHALE") == 37);
+  REQUIRE(!strcmp(buffer, "pressure="));
+
+  test::printf_arg_type args[3];
+  args[0].tag = test::PRINTF_ARG_INT;    args[0].value.i = -7;
+  args[1].tag = test::PRINTF_ARG_DOUBLE; args[1].value.d = 1.25;
+  args[2].tag = test::PRINTF_ARG_STRING; args[2].value.s = "EXHALE";
+  REQUIRE(test::snprintf_args(buffer, sizeof(buffer), handle, args, 3U) == 37);
+  REQUIRE(!strcmp(buffer, "pressure=-7 flow=1.25   state=EXHALE\n"));
+
+  // mismatched and missing arguments are defined
+  args[0].tag = test::PRINTF_ARG_DOUBLE; args[0].value.d = 42.9;
+  args[1].tag = test::PRINTF_ARG_UINT;   args[1].value.u = 3U;
+  REQUIRE(test::snprintf_args(buffer, sizeof(buffer), handle, args, 2U) == 31);
+  REQUIRE(!strcmp(buffer, "pressure=42 flow=3.00   state=\n"));
+  REQUIRE(test::snprintf_args(buffer, sizeof(buffer), handle, nullptr, 0U) == 30);
+  REQUIRE(!strcmp(buffer, "pressure=0 flow=0.00   state=\n"));
+
+  // star width and precision, literal only and trailing specifier formats
+  REQUIRE(test::printf_compile(handle, 4U, "%*.*d|%%|%c") == 4);
+  REQUIRE(test::snprintf_compiled(buffer, sizeof(buffer), handle, 6, 3, 5, 'x') == 10);
+  REQUIRE(!strcmp(buffer, "   005|%|x"));
+  REQUIRE(test::printf_compile(handle, 4U, "no conversion") == 1);
+  REQUIRE(test::snprintf_compiled(buffer, sizeof(buffer), handle) == 13);
+  REQUIRE(!strcmp(buffer, "no conversion"));
+  REQUIRE(test::printf_compile(handle, 1U, "%d") == 2);
+  REQUIRE(test::snprintf_compiled(buffer, sizeof(buffer), handle, 1) == 0);
+  REQUIRE(!strcmp(buffer, ""));
+}
+
+
+// format at compile time and at runtime, both must give the same result
+#define REQUIRE_COMPILE_TIME(format, ...) \
+  do { \
+    char runtime_[100], compile_time_[100]; \
+    const int len_ = test::snprintf(runtime_, sizeof(runtime_), format, ##__VA_ARGS__); \
+    REQUIRE(TINY_FORMAT(compile_time_, sizeof(compile_time_), format, ##__VA_ARGS__) == len_); \
+    REQUIRE(!strcmp(compile_time_, runtime_)); \
+  } while (0)
+
+
+TEST_CASE("compile time format", "[]" ) {
+  char buffer[100];
+  const char* null_string = nullptr;
+  int value = 42;
+
+  static constexpr char literal_only[] = "literal only";
+  REQUIRE(tiny::format<literal_only>(buffer, sizeof(buffer)) == 12);
+  REQUIRE(!strcmp(buffer, "literal only"));
+  REQUIRE_COMPILE_TIME("x=%d y=%5.2f", -17, 3.14159);
+  REQUIRE_COMPILE_TIME("% d|%+d|%-5d|%05d|%.3d|%i", 42, 42, -42, -42, 7, 0);
+  REQUIRE_COMPILE_TIME("%u|%x|%#X|%#o|%b|%#010x", 4294967295U, 0xbeefU, 0xbeefU, 8U, 5U, 255U);
+  REQUIRE_COMPILE_TIME("%hhd|%hd|%hhu|%hu", 300, 70000, 300, 70000);
+  REQUIRE_COMPILE_TIME("%ld|%lu|%lld|%llx", -2147483647L, 4294967295UL, -9223372036854775807LL, 0x1234567890abcdefULL);
+  REQUIRE_COMPILE_TIME("%zu|%td|%jd", sizeof(buffer), (ptrdiff_t)-3, (intmax_t)-9);
+  REQUIRE_COMPILE_TIME("%f|%.0f|%10.3f|%-8.1f|%F", 1.5, 2.5, -3.14159, 0.05, 42.0);
+#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
+  REQUIRE_COMPILE_TIME("%e|%.2E|%g|%G|%10.4g", 12345.678, 0.000123, 0.0001, 1e20, 3.1415926);
+#endif
+  REQUIRE_COMPILE_TIME("%f|%f|%f", (double)NAN, (double)INFINITY, -(double)INFINITY);
+  REQUIRE_COMPILE_TIME("%c|%3c|%-3c|", 'a', 'b', 'c');
+  REQUIRE_COMPILE_TIME("%s|%10s|%-10s|%.2s|%.0s", "Hello", "right", "left", "truncate", "none");
+  REQUIRE_COMPILE_TIME("%*d|%-*d|%*d|%.*f|%*.*s", 5, 1, 5, 2, -5, 3, 2, 2.345, 6, 2, "abc");
+  REQUIRE_COMPILE_TIME("%p|%%|100%%", (void*)&value);
+  REQUIRE_COMPILE_TIME("%d%%", 99);
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP
+  REQUIRE_COMPILE_TIME("%r|%hr|%12R", 0.1, 2.0 / 3.0, 1e-7);
+#endif
+
+  // truncation and length only
+  REQUIRE(TINY_FORMAT(buffer, 6U, "x=%d y=%5.2f", -17, 3.14159) == 13);
+  REQUIRE(!strcmp(buffer, "x=-17"));
+  REQUIRE(TINY_FORMAT(nullptr, 0U, "x=%d y=%5.2f", -17, 3.14159) == 13);
+  REQUIRE(TINY_FORMAT(buffer, 0U, "%s", "untouched") == 9);
+  REQUIRE(!strcmp(buffer, "x=-17"));
+
+  // a NULL string is printed like snprintf_args() does
+  REQUIRE(TINY_FORMAT(buffer, sizeof(buffer), "%s", null_string) == 6);
+  REQUIRE(!strcmp(buffer, "(null)"));
+}
+
+
+TEST_CASE("typed arguments", "[]" ) {
+  char buffer[100], expected[100];
+  const char* null_string = nullptr;
+  enum { ENUM_VALUE = 3 };
+
+  // same output as the va_list engine for matching types
+  test::sprintf(expected, "%d|%5u|%-4x|%llX|%.3f|%c|%10s|%p|%%", -42, 7U, 0xabU, 0x1234567890ULL, 1.5, 'z', "right", (void*)buffer);
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%d|%5u|%-4x|%llX|%.3f|%c|%10s|%p|%%", -42, 7U, 0xabU, 0x1234567890ULL, 1.5, 'z', "right", (void*)buffer) == (int)strlen(expected));
+  REQUIRE(!strcmp(buffer, expected));
+#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
+  test::sprintf(expected, "%e|%.2G", 2.5e10, 1e-7);
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%e|%.2G", 2.5e10, 1e-7) == (int)strlen(expected));
+  REQUIRE(!strcmp(buffer, expected));
+#endif
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%*.*f|%-*d|", 8, 2, 3.14159, 4, 5) == 14);
+  REQUIRE(!strcmp(buffer, "    3.14|5   |"));
+
+  // no promotion, no truncation to int without length modifier
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%f %d %u %x", 0.1f, 1LL << 40, 1ULL << 33, -1) == 42);
+  REQUIRE(!strcmp(buffer, "0.100000 1099511627776 8589934592 ffffffff"));
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%d %d %hhd %u", (short)-5, ENUM_VALUE, 300, (unsigned char)200) == 11);
+  REQUIRE(!strcmp(buffer, "-5 3 44 200"));
+
+  // mismatches are defined
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%d|%f|%s|%s|%d|", 42.9, 3, 5, null_string) == 22);
+  REQUIRE(!strcmp(buffer, "42|3.000000||(null)|0|"));
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%d|%x", "abc", "abc") == 3);
+  REQUIRE(!strcmp(buffer, "0|0"));
+  const char* string = "abc";
+  test::sprintf(expected, "%p", (const void*)string);
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "%p", string) == (int)strlen(expected));
+  REQUIRE(!strcmp(buffer, expected));
+  REQUIRE(tiny::snformat(buffer, sizeof(buffer), "no arguments") == 12);
+  REQUIRE(!strcmp(buffer, "no arguments"));
+  REQUIRE(tiny::snformat(nullptr, 0U, "%d", 12345) == 5);
+}
+
+
+#if defined(PRINTF_SUPPORT_BINARY)
+// encode a binary record, decode it and compare with the directly formatted text
+template <typename... Args>
+static bool binary_round_trip(size_t* size, const char* format, Args... args)
+{
+  unsigned char record[100];
+  char expected[100], decoded[100];
+  uintptr_t key = 0U;
+
+  *size = (size_t)test::binprintf(record, sizeof(record), format, args...);
+  const size_t header = test::binheader(record, *size, &key);
+  const int len = test::binsnprintf(decoded, sizeof(decoded), (const char*)key, record + header, *size - header);
+  test::sprintf(expected, format, args...);
+  return (key == (uintptr_t)format) && (len == (int)strlen(expected)) && !strcmp(decoded, expected);
+}
+
+
+TEST_CASE("binary", "[]" ) {
+  size_t size;
+
+  REQUIRE(binary_round_trip(&size, "pressure=%d flow=%d volume=%d\n", 12, -3, 456));
+  REQUIRE(size < 16U);
+  REQUIRE(binary_round_trip(&size, "%i %hhd %hd %ld %lld", -2147483647 - 1, -128, -32768, -123456789L, -1234567890123456789LL));
+  REQUIRE(binary_round_trip(&size, "%u %#x %X %#o %b %hhu %lu %llX", 4294967295U, 0xBEEFU, 0xCAFEU, 0755U, 5U, 255U, 4294967295UL, 0xFEDCBA9876543210ULL));
+  REQUIRE(binary_round_trip(&size, "%c|%-5c|%5c", 'a', 'b', 'c'));
+  REQUIRE(binary_round_trip(&size, "%s|%10s|%-10.3s|%.*s|%s", "ventilator", "flow", "pressure", 2, "volume", ""));
+  REQUIRE(binary_round_trip(&size, "%*d|%-*d|%.*d", 8, 42, -8, 42, 5, 42));
+  REQUIRE(binary_round_trip(&size, "%p", (void*)(uintptr_t)0x1234U));
+  REQUIRE(binary_round_trip(&size, "%.3f %e %g %G %-10.2f", 3.14159, -1.5e-10, 0.0001234, 1e20, 2.5));
+  REQUIRE(binary_round_trip(&size, "100%% literal"));
+
+  // size only, and truncated records decode without overrun
+  unsigned char record[100];
+  char buffer[100];
+  const char* format = "%s=%d";
+  const int size_only = test::binprintf(nullptr, 0U, format, "flow", 1000);
+  REQUIRE(test::binprintf(record, sizeof(record), format, "flow", 1000) == size_only);
+  uintptr_t key;
+  const size_t header = test::binheader(record, (size_t)size_only, &key);
+  REQUIRE(test::binsnprintf(buffer, sizeof(buffer), format, record + header, 3U) == 2);
+  REQUIRE(!strcmp(buffer, "=0"));
+
+  // stream output
+  size_t calls = 0U;
+  printf_idx = 0U;
+  REQUIRE(test::fctbinprintf(&_out_fct_span, &calls, format, "flow", 1000) == size_only);
+  REQUIRE(printf_idx == (size_t)size_only);
+  REQUIRE(!memcmp(printf_buffer, record, printf_idx));
+
+  // a NULL string is stored as "(null)"
+  const char* null_string = nullptr;
+  const int null_size = test::binprintf(record, sizeof(record), "%s|%.3s", null_string, null_string);
+  const size_t null_header = test::binheader(record, (size_t)null_size, &key);
+  REQUIRE(test::binsnprintf(buffer, sizeof(buffer), "%s|%.3s", record + null_header, (size_t)null_size - null_header) == 10);
+  REQUIRE(!strcmp(buffer, "(null)|(nu"));
+
+  // pointers are printed with the pointer size of the target which encoded the record
+  const unsigned char pointer32[] = { 4U, 0xB4U, 0x24U };
+  const unsigned char pointer64[] = { 8U, 0xB4U, 0x24U };
+  REQUIRE(test::binsnprintf(buffer, sizeof(buffer), "%p", pointer32, sizeof(pointer32)) == 8);
+  REQUIRE(!strcmp(buffer, "00001234"));
+  REQUIRE(test::binsnprintf(buffer, sizeof(buffer), "%p", pointer64, sizeof(pointer64)) == 16);
+  REQUIRE(!strcmp(buffer, "0000000000001234"));
+}
+
+
+namespace test {
+  static int binary_dictionary_record(unsigned char* record, size_t count, int value)
+  {
+    return BINPRINTF(record, count, "dictionary flow=%d %s\n", value, "ok");
+  }
+} // namespace test
+
+
+TEST_CASE("binary dictionary", "[]" ) {
+  unsigned char record[100];
+  char buffer[100];
+  uintptr_t id;
+
+  const int size = test::binary_dictionary_record(record, sizeof(record), -42);
+  const size_t header = test::binheader(record, (size_t)size, &id);
+  REQUIRE(id < 65536U);
+  REQUIRE(size < 8);
+
+  // extract the dictionary from this host built ELF image
+  size_t dict_size = 0U;
+  char* dict = printf_dict_load("/proc/self/exe", &dict_size);
+  REQUIRE(dict != nullptr);
+  const char* format = printf_dict_lookup(dict, dict_size, id);
+  REQUIRE(format != nullptr);
+  REQUIRE(!strcmp(format, "dictionary flow=%d %s\n"));
+  REQUIRE(printf_dict_lookup(dict, dict_size, id + 1U) == nullptr);
+  REQUIRE(printf_dict_lookup(dict, dict_size, dict_size) == nullptr);
+
+  REQUIRE(test::binsnprintf(buffer, sizeof(buffer), format, record + header, (size_t)size - header) == 23);
+  REQUIRE(!strcmp(buffer, "dictionary flow=-42 ok\n"));
+  free(dict);
+}
+#endif
+
+
+#if defined(PRINTF_SUPPORT_RING)
+TEST_CASE("ring", "[]" ) {
+  alignas(4) char storage[32];
+  test::printf_ring_type ring;
+  char line[100];
+
+  REQUIRE(test::printf_ring_init(&ring, storage, 24U) == -1);
+  REQUIRE(test::printf_ring_init(&ring, storage + 1, 16U) == -1);
+  REQUIRE(test::printf_ring_init(&ring, storage, sizeof(storage)) == 0);
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == -1);
+
+  REQUIRE(test::printf_ring(&ring, "ab%d", 12) == 4);
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == 4);
+  REQUIRE(!strcmp(line, "ab12"));
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == -1);
+
+  // records of 5 characters take 12 bytes, the third one is dropped
+  REQUIRE(test::printf_ring(&ring, "%5d", 1) == 5);
+  REQUIRE(test::printf_ring(&ring, "%-5s", "two") == 5);
+  REQUIRE(test::printf_ring(&ring, "%5d", 3) == -1);
+  REQUIRE(ring.dropped == 1U);
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == 5);
+  REQUIRE(!strcmp(line, "    1"));
+
+  // wraps around the end of the storage
+  REQUIRE(test::printf_ring(&ring, "%05d", -42) == 5);
+  REQUIRE(test::printf_ring_read(&ring, line, 3U) == 5);
+  REQUIRE(!strcmp(line, "tw"));
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == 5);
+  REQUIRE(!strcmp(line, "-0042"));
+  REQUIRE(test::printf_ring(&ring, "") == 0);
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == 0);
+  REQUIRE(!strcmp(line, ""));
+  REQUIRE(test::printf_ring_read(&ring, line, sizeof(line)) == -1);
+
+  REQUIRE(test::printf_ring(&ring, "%40s", "") == -1);
+  REQUIRE(ring.dropped == 2U);
+}
+#endif
+
+
+TEST_CASE("power of two bases", "[]" ) {
+  char buffer[100];
+
+  test::sprintf(buffer, "%llx|%llX|%016llx|%llx", 0xfedcba9876543210ULL, 0xfedcba9876543210ULL, 0xabcULL, 0ULL);
+  REQUIRE(!strcmp(buffer, "fedcba9876543210|FEDCBA9876543210|0000000000000abc|0"));
+  test::sprintf(buffer, "%lx|%#lX|%x|%#x", 0x7fffffffUL, 0x10UL, 0xffffffffU, 0x1U);
+  REQUIRE(!strcmp(buffer, "7fffffff|0X10|ffffffff|0x1"));
+  test::sprintf(buffer, "%llo|%o|%#o", 01777777777777777777777ULL, 8U, 0U);
+  REQUIRE(!strcmp(buffer, "1777777777777777777777|10|0"));
+  test::sprintf(buffer, "%b|%#b|%llb", 0xa5U, 1U, 0x80000000ULL);
+  REQUIRE(!strcmp(buffer, "10100101|0b1|10000000000000000000000000000000"));
+  test::sprintf(buffer, "%.0x|%.0llx|%5.3llx", 0U, 0ULL, 0x1ULL);
+  REQUIRE(!strcmp(buffer, "||  001"));
+}
+
+
+TEST_CASE("wide padding", "[]" ) {
+  char buffer[100];
+
+  // padding is not limited by the conversion buffers
+  test::sprintf(buffer, "%040d|%-40x|", -42, 0xabcU);
+  REQUIRE(!strcmp(buffer, "-000000000000000000000000000000000000042|abc                                     |"));
+  test::sprintf(buffer, "%.40u", 7U);
+  REQUIRE(!strcmp(buffer, "0000000000000000000000000000000000000007"));
+  test::sprintf(buffer, "%+040.3f|%.20f", 3.14159, 0.5);
+  REQUIRE(!strcmp(buffer, "+00000000000000000000000000000000003.142|0.50000000000000000000"));
+
+  // fills are cut at the end of the buffer
+  memset(buffer, 0xCC, sizeof(buffer));
+  REQUIRE(test::snprintf(buffer, 10U, "%30s", "x") == 30);
+  REQUIRE(!strcmp(buffer, "         "));
+  REQUIRE(buffer[10] == (char)0xCC);
+  REQUIRE(test::snprintf(buffer, 8U, "%c%-40c|", 'a', 'b') == 42);
+  REQUIRE(!strcmp(buffer, "ab     "));
+
+  // same output through a span sink, which can't be written to directly
+  size_t calls = 0U;
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  REQUIRE(test::fctprintf_span(&_out_fct_span, &calls, "%#034llx|%-12.2f|", 0x123456789abcdefULL, -1.005) == 48);
+  printf_buffer[48] = 0;
+  REQUIRE(!strcmp(printf_buffer, "0x00000000000000000123456789abcdef|-1.00       |"));
+}
+
+
+// the measured length must be the length of the formatted output
+#define REQUIRE_MEASURE(format, ...) \
+  do { \
+    const int written_ = test::snprintf(buffer, sizeof(buffer), format, __VA_ARGS__); \
+    REQUIRE(test::printf_measure(format, __VA_ARGS__) == written_); \
+    REQUIRE(test::snprintf(nullptr, 0U, format, __VA_ARGS__) == written_); \
+  } while (0)
+
+
+// resumable output sink, takes up to 'room' characters per printf_resume() call
+struct resume_sink {
+  char   text[200];
+  size_t len;
+  size_t room;
+};
+
+static size_t resume_out(const char* data, size_t len, void* arg)
+{
+  resume_sink* sink = (resume_sink*)arg;
+  const size_t n = len < sink->room ? len : sink->room;
+  memcpy(sink->text + sink->len, data, n);
+  sink->len  += n;
+  sink->room -= n;
+  return n;
+}
+
+// resume in slices of 'room' characters, a call with no room at all first
+static void resume_slices(test::printf_resume_type* state, resume_sink* sink, size_t room)
+{
+  sink->len  = 0U;
+  sink->room = 0U;
+  REQUIRE(test::printf_resume(state, &resume_out, sink) == 1);
+  do {
+    sink->room = room;
+  } while (test::printf_resume(state, &resume_out, sink));
+  sink->text[sink->len] = 0;
+  REQUIRE(state->idx == sink->len);
+}
+
+static void resume_va(test::printf_resume_type* state, resume_sink* sink, size_t room, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  test::vprintf_resume_init(state, format, args);
+  resume_slices(state, sink, room);
+  va_end(args);
+}
+
+
+TEST_CASE("resumable", "[]" ) {
+  char expected[200];
+  resume_sink sink;
+  test::printf_resume_type state;
+  const char* format = "x=%d|%-12s|%010.3f|%%|%5c|%#llx|%*d end of the line";
+  const test::printf_arg_type args[] = {
+    { test::PRINTF_ARG_INT, { -42 } },
+    { test::PRINTF_ARG_STRING, { 0 } },
+    { test::PRINTF_ARG_DOUBLE, { 0 } },
+    { test::PRINTF_ARG_INT, { 'z' } },
+    { test::PRINTF_ARG_UINT, { 0 } },
+    { test::PRINTF_ARG_INT, { 20 } },
+    { test::PRINTF_ARG_INT, { 7 } }
+  };
+  test::printf_arg_type typed[7];
+  memcpy(typed, args, sizeof(typed));
+  typed[1].value.s = "left";
+  typed[2].value.d = -3.14159;
+  typed[4].value.u = 0x123456789abcdefULL;
+  const int len = test::sprintf(expected, format, -42, "left", -3.14159, 'z', 0x123456789abcdefULL, 20, 7);
+
+  for (size_t room = 1U; room < 10U; ++room) {
+    test::printf_resume_init(&state, format, typed, 7U);
+    resume_slices(&state, &sink, room);
+    REQUIRE(!strcmp(sink.text, expected));
+
+    resume_va(&state, &sink, room, format, -42, "left", -3.14159, 'z', 0x123456789abcdefULL, 20, 7);
+    REQUIRE(!strcmp(sink.text, expected));
+  }
+  REQUIRE(sink.len == (size_t)len);
+
+  // complete in one call with enough room, nothing is left afterwards
+  test::printf_resume_init(&state, format, typed, 7U);
+  sink.len  = 0U;
+  sink.room = sizeof(sink.text);
+  REQUIRE(test::printf_resume(&state, &resume_out, &sink) == 0);
+  REQUIRE(test::printf_resume(&state, &resume_out, &sink) == 0);
+  REQUIRE(sink.len == (size_t)len);
+
+#if defined(PRINTF_SUPPORT_BINARY)
+  unsigned char record[100];
+  uintptr_t key;
+  const int size = test::binprintf(record, sizeof(record), "%s=%-6d|%.2f", "flow", -1000, 2.5);
+  const size_t header = test::binheader(record, (size_t)size, &key);
+  test::printf_resume_init_binary(&state, (const char*)key, record + header, (size_t)size - header);
+  resume_slices(&state, &sink, 3U);
+  REQUIRE(!strcmp(sink.text, "flow=-1000 |2.50"));
+#endif
+}
+
+
+TEST_CASE("measure", "[]" ) {
+  char buffer[200];
+
+  REQUIRE(test::printf_measure("Hello, world") == 12);
+  REQUIRE(test::printf_measure("") == 0);
+  REQUIRE_MEASURE("%d|%i|%u", 0, -2147483647 - 1, 4294967295U);
+  REQUIRE_MEASURE("% d|%+d|%-6d|%06d|%.0d|% .0d", 42, 42, -42, -42, 0, 0);
+  REQUIRE_MEASURE("%.8d|%12.5d|%-+8.3d", 123, -45, 6);
+  REQUIRE_MEASURE("%x|%#x|%#X|%#o|%#b|%#.0x|%#08x|%#3o", 0xbeefU, 0xbeefU, 0U, 8U, 5U, 0U, 0x1fU, 0U);
+  REQUIRE_MEASURE("%hhd|%hu|%ld|%lx|%lld|%llu|%#llo", 300, 70000, -123456789L, 0xdeadbeefUL, -1234567890123LL, 18446744073709551615ULL, 01777ULL);
+  REQUIRE_MEASURE("%*d|%-*x|%.*u|%*.*d", 8, 5, -6, 0xaU, 4, 3U, -10, 3, -7);
+  REQUIRE_MEASURE("%c|%5c|%-3c", 'a', 'b', 'c');
+  REQUIRE_MEASURE("%s|%10s|%-10s|%.3s|%.0s|%.*s|%8.2s", "hello", "hi", "left", "foobar", "x", 4, "abcdefgh", "xyz");
+  REQUIRE_MEASURE("%%|%5%|%p|%y", (void*)0x1234);
+  REQUIRE_MEASURE("%f|%.0f|%.3f|%10.4f|%-10.2f|%+f|% .1f", 3.14159, 0.5, -0.0005, 1.999999, -42.0, 1e9, 2.55);
+  REQUIRE_MEASURE("%#.0f|%09.3f|%.9f|%.12f|%f", 7.0, -1.25, 0.123456789, 1.0 / 3.0, 4294967295.5);
+  REQUIRE_MEASURE("%f|%8f|%-8f|%+f|%.2f", 1e200, (double)NAN, -(double)INFINITY, (double)INFINITY, 1e-12);
+#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
+  REQUIRE_MEASURE("%e|%.3E|%g|%G|%10.3g|%#g", 12345.678, -0.000123, 1e-5, 3e20, 99.99, 1.0);
+#endif
+  REQUIRE_MEASURE("%s %d%", "dangling", 1);
+
+  // pre-parsed formats without a buffer are measured the same way
+  test::printf_op_type handle[4];
+  REQUIRE(test::printf_compile(handle, 4U, "pressure=%d flow=%-6.2f state=%s\n") == 4);
+  REQUIRE(test::snprintf_compiled(nullptr, 0U, handle, 12, -3.5, "INHALE") == 37);
+}
+
+
+// the truncating variant must leave the same characters in the buffer as snprintf()
+#define REQUIRE_TRUNC(format, ...) \
+  for (size_t count_ = 0U; count_ < 48U; ++count_) { \
+    memset(buffer, 0xCC, sizeof(buffer)); \
+    memset(expected, 0xCC, sizeof(expected)); \
+    const int full_ = test::snprintf(expected, count_, format, __VA_ARGS__); \
+    REQUIRE(test::snprintf_trunc(buffer, count_, format, __VA_ARGS__) == (full_ < (int)count_ ? full_ : -1)); \
+    REQUIRE(!memcmp(buffer, expected, sizeof(buffer))); \
+  }
+
+
+TEST_CASE("truncation mode", "[]" ) {
+  char buffer[64];
+  char expected[64];
+
+  REQUIRE(test::snprintf_trunc(buffer, 10U, "%d", 123) == 3);
+  REQUIRE(!strcmp(buffer, "123"));
+  REQUIRE(test::snprintf_trunc(buffer, 4U, "%d", 123) == 3);
+  REQUIRE(!strcmp(buffer, "123"));
+  REQUIRE(test::snprintf_trunc(buffer, 3U, "%d", 123) == -1);
+  REQUIRE(!strcmp(buffer, "12"));
+  REQUIRE(test::snprintf_trunc(buffer, 1U, "") == 0);
+  REQUIRE(test::snprintf_trunc(nullptr, 0U, "") == 0);
+  REQUIRE(test::snprintf_trunc(nullptr, 0U, "x") == -1);
+
+  REQUIRE_TRUNC("%s|%10s|%-10s|%.3s|", "hello world", "abc", "left", "foobar");
+  REQUIRE_TRUNC("%20s|%-20s|", "a rather long string argument", "short");
+  REQUIRE_TRUNC("%*s|%-*.*s|%*s", 12, "star", -15, 4, "precision", -3, "x");
+  REQUIRE_TRUNC("pressure=%d flow=%-6.2f state=%s", 12, -3.5, "INHALE");
+  REQUIRE_TRUNC("%#010x|%-8d|%+.5i|%c%5c", 0xbeefU, -42, 17, 'a', 'b');
+  REQUIRE_TRUNC("%40s%d", "", 7);
+
+  // the scan of a string argument stops behind the buffer, the rest isn't read
+  char large[10000];
+  memset(large, 'x', sizeof(large));
+  large[sizeof(large) - 1U] = 0;
+  REQUIRE(test::snprintf_trunc(buffer, 16U, "%s", large) == -1);
+  REQUIRE(!strcmp(buffer, "xxxxxxxxxxxxxxx"));
+}
+
+
+#if defined(PRINTF_FLOAT_INTEGER_ONLY) && !defined(PRINTF_DISABLE_SUPPORT_EXPONENTIAL)
+TEST_CASE("integer only exponential", "[]" ) {
+  char buffer[100];
+
+  // exactly rounded, also where the rounding carries into the exponent
+  test::sprintf(buffer, "%.2e|%e|%.0E|%.3e", 9.9999999e5, 999999.5, 99.5, 0.00099995);
+  REQUIRE(!strcmp(buffer, "1.00e+06|9.999995e+05|1E+02|1.000e-03"));
+
+  test::sprintf(buffer, "%e|%.2e|%e", 0.0, 5e-324, 1.7976931348623157e308);
+  REQUIRE(!strcmp(buffer, "0.000000e+00|4.94e-324|1.797693e+308"));
+
+  test::sprintf(buffer, "%.30e", 1e-300);
+  REQUIRE(!strcmp(buffer, "1.000000000000000025059091835209e-300"));
+
+  test::sprintf(buffer, "%.1e|%.1e|%.0e|%.0e", 0.25, 0.35, 2.5, 3.5);
+  REQUIRE(!strcmp(buffer, "2.5e-01|3.5e-01|2e+00|4e+00"));
+
+  test::sprintf(buffer, "%g|%.3g|%G|%g", 1e-5, 999999.5, 1e300, 0.0);
+  REQUIRE(!strcmp(buffer, "1.000000e-05|1000000|1.000000E+300|0.000000e+00"));
+
+  REQUIRE_MEASURE("%e|%.0e|%12.3E|%-12.1e|%+e|%g|%.3g", 9.9999999e5, 1e-300, -0.00099995, 5e-324, 0.0, 123456789.0, 1e-5);
+}
+#endif
+
+
+#ifndef PRINTF_DISABLE_SUPPORT_FLOAT32
+TEST_CASE("float32", "[]" ) {
+  char buffer[100];
+
+  // %hf rounds the argument to float
+  test::sprintf(buffer, "%.10hf|%hf|%.12hf", 0.1, 16777217.0, 1.0 / 3.0);
+  REQUIRE(!strcmp(buffer, "0.1000000015|16777216.000000|0.333333343267"));
+
+  test::sprintf(buffer, "%.3hf|%.1hf|%.0hf|%.20hf", 2.5e-3, 0.25, 2.5, 1e-10);
+  REQUIRE(!strcmp(buffer, "0.002|0.2|2|0.00000000010000000134"));
+
+  test::sprintf(buffer, "%.50hf", 1e-45);
+  REQUIRE(!strcmp(buffer, "0.00000000000000000000000000000000000000000000140130"));
+
+  test::sprintf(buffer, "%hf|%hf|%5hf|%-6hF|%+hf", 3.4028235e38, 1e39, (double)NAN, -1e39, 1e-50);
+  REQUIRE(!strcmp(buffer, "340282346638528859811704183484516925440.000000|inf|  nan|-inf  |+0.000000"));
+
+  REQUIRE_MEASURE("%hf|%.3hf|%10.2hf|%-12.1hf|%hf", 0.1, -2.5e-3, 1e20, 3.75, 1e39);
+
+  // float arguments of the compile time front end aren't promoted
+  const float third = 1.0f / 3.0f;
+  REQUIRE(TINY_FORMAT(buffer, sizeof(buffer), "%.12f|%08.3f|%hf", third, -third, 0.1) == 32);
+  REQUIRE(!strcmp(buffer, "0.333333343267|-000.333|0.100000"));
+}
+#endif
+
+
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP
+TEST_CASE("round-trip", "[]" ) {
+  char buffer[100];
+
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP_DOUBLE
+  test::sprintf(buffer, "%r|%r|%r|%r|%r", 0.1, 1.0, 100.0, 1.5e-5, 0.0001);
+  REQUIRE(!strcmp(buffer, "0.1|1|100|1.5e-05|0.0001"));
+
+  test::sprintf(buffer, "%r|%r|%r", 1e16, 1e17, 123456789012345680.0);
+  REQUIRE(!strcmp(buffer, "10000000000000000|1e+17|1.2345678901234568e+17"));
+
+  test::sprintf(buffer, "%r|%r|%r|%r", 5e-324, DBL_MAX, 2.0 / 3.0, -0.0);
+  REQUIRE(!strcmp(buffer, "5e-324|1.7976931348623157e+308|0.6666666666666666|0"));
+
+  test::sprintf(buffer, "%R|%+12.3R|%-10r|%010r", 1e-300, 1.5e-5, 2.5, -2.5);
+  REQUIRE(!strcmp(buffer, "1E-300|    +1.5E-05|2.5       |-0000002.5"));
+#endif
+
+  test::sprintf(buffer, "%hr|%hr|%hr|%hR", 2.0 / 3.0, 0.1, 16777216.0, 1e30);
+  REQUIRE(!strcmp(buffer, "0.6666667|0.1|16777216|1E+30"));
+
+  test::sprintf(buffer, "%r|%R|%5r", (double)NAN, -(double)INFINITY, (double)INFINITY);
+  REQUIRE(!strcmp(buffer, "nan|-inf|  inf"));
+
+  // shortest output reads back to the same value
+  uint64_t state = 88172645463325252ULL;
+  for (int i = 0; i < 20000; ++i) {
+    state ^= state << 13U; state ^= state >> 7U; state ^= state << 17U;
+    float f;
+    const uint32_t fbits = (uint32_t)state & 0x7f7fffffU;
+    memcpy(&f, &fbits, sizeof(f));
+    test::sprintf(buffer, "%hr", (double)f);
+    REQUIRE(strtof(buffer, nullptr) == f);
+#ifndef PRINTF_DISABLE_SUPPORT_ROUNDTRIP_DOUBLE
+    double d;
+    const uint64_t dbits = state & 0x7fefffffffffffffULL;
+    memcpy(&d, &dbits, sizeof(d));
+    test::sprintf(buffer, "%r", d);
+    REQUIRE(strtod(buffer, nullptr) == d);
+#endif
+  }
+}
+#endif
+
+
+TEST_CASE("fixed point", "[]" ) {
+  char buffer[100];
+
+  test::sprintf(buffer, "%k16|%.3k16|%hk15|%.5hk15|%.2k", 0x18000, -0x18000, -32768, 0x4000, 42);
+  REQUIRE(!strcmp(buffer, "1.500000|-1.500|-1.000000|0.50000|42.00"));
+
+  // correctly rounded, ties to even
+  test::sprintf(buffer, "%.3k4|%.3k4|%.0k1|%.0k1|%.2k4|%.1k4|%.2k8", 25, 27, 5, 7, 0x1F, 0xFF, 0x1FF);
+  REQUIRE(!strcmp(buffer, "1.562|1.688|2|4|1.94|15.9|2.00"));
+  test::sprintf(buffer, "%.9k31|%.20k31|%.8k4", 0x7FFFFFFF, 1, 0x18);
+  REQUIRE(!strcmp(buffer, "1.000000000|0.00000000046566128731|1.50000000"));
+
+  // unsigned and long long
+  test::sprintf(buffer, "%K16|%.3K8|%.3llk32|%llK60", 0xFFFFFFFFU, 0x100U, -(5LL << 32) - (1LL << 31), 1ULL << 63U);
+  REQUIRE(!strcmp(buffer, "65535.999985|1.000|-5.500|8.000000"));
+
+  // sign, width and padding like integers
+  test::sprintf(buffer, "%+08.2k8|%-8.1k8|% .1k8|%#.0k8|%10.3K8|%*.*k8", 0x180, -0x180, 0x80, 0x180, 0x280U, 8, 2, 0x180);
+  REQUIRE(!strcmp(buffer, "+0001.50|-1.5    | 0.5|2|     2.500|    1.50"));
+  test::sprintf(buffer, "%.1k8%%|%+K8", 0x80, 0x80U);
+  REQUIRE(!strcmp(buffer, "0.5%|0.500000"));
+
+  REQUIRE_MEASURE("%k16|%-12.4k8|%08.1k4|%.0k1|%.3llk40", -0x18000, 0x1FF, -0x1F, 7, 1LL << 41);
+  REQUIRE_COMPILE_TIME("%k16|%.3hk15|%-8.1K8|%+09.4llk32", 0x18000, -16384, 0x180U, -(3LL << 31));
+#if defined(PRINTF_SUPPORT_BINARY)
+  size_t size;
+  REQUIRE(binary_round_trip(&size, "%k16 %.2hK8 %.4llk32", -0x18000, 0x1FFU, 5LL << 30));
+#endif
+}
+
+
 TEST_CASE("misc", "[]" ) {
   char buffer[100];
 
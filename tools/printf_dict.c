@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+// \author (c) Marco Paland (info@paland.com)
+//             2014-2019, PALANDesign Hannover, Germany
+//
+// \license The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// \brief Host tool for deferred (binary) logging with a format string dictionary.
+//        Extracts the "printf_formats" section (filled by PRINTF_FORMAT()) from a
+//        firmware ELF image, the offset of each format string is its ID.
+//
+//        printf_dict <firmware.elf>
+//          prints the dictionary, one "ID<tab>format" line per format string
+//        printf_dict <firmware.elf> -
+//          decodes BINPRINTF() records from stdin, one hex encoded record per line
+//
+//        Build: gcc -o printf_dict tools/printf_dict.c printf.c
+//        Define PRINTF_DICT_NO_MAIN to use the dictionary functions only.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <elf.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// name of the dictionary section
+#define PRINTF_DICT_SECTION  "printf_formats"
+
+
+// internal read of a whole file
+// \return malloc'ed file contents, NULL on error
+static unsigned char* _dict_read_file(const char* path, size_t* size)
+{
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    return NULL;
+  }
+  unsigned char* data = NULL;
+  if (!fseek(f, 0L, SEEK_END)) {
+    const long len = ftell(f);
+    if ((len > 0) && !fseek(f, 0L, SEEK_SET)) {
+      data = (unsigned char*)malloc((size_t)len);
+      if (data && (fread(data, 1U, (size_t)len, f) != (size_t)len)) {
+        free(data);
+        data = NULL;
+      }
+      *size = (size_t)len;
+    }
+  }
+  fclose(f);
+  return data;
+}
+
+
+// internal ELF section header, independent of the ELF class
+typedef struct {
+  size_t name;
+  size_t offset;
+  size_t size;
+} dict_section_type;
+
+
+// internal read of section header 'index'
+static void _dict_section(const unsigned char* image, bool is64, size_t shoff, size_t shentsize, size_t index, dict_section_type* section)
+{
+  const unsigned char* sh = image + shoff + index * shentsize;
+  if (is64) {
+    Elf64_Shdr h;
+    memcpy(&h, sh, sizeof(h));
+    section->name = h.sh_name; section->offset = (size_t)h.sh_offset; section->size = (size_t)h.sh_size;
+  }
+  else {
+    Elf32_Shdr h;
+    memcpy(&h, sh, sizeof(h));
+    section->name = h.sh_name; section->offset = h.sh_offset; section->size = h.sh_size;
+  }
+}
+
+
+// internal search of the dictionary section in an ELF32 or ELF64 image of host byte order
+// \return true if found, 'section' locates the section contents in the image
+static bool _dict_find_section(const unsigned char* image, size_t image_size, dict_section_type* section)
+{
+  if ((image_size < EI_NIDENT) || memcmp(image, ELFMAG, SELFMAG)) {
+    return false;
+  }
+
+  const bool is64 = image[EI_CLASS] == ELFCLASS64;
+  size_t shoff, shentsize, shnum, shstrndx;
+  if (is64) {
+    Elf64_Ehdr eh;
+    if (image_size < sizeof(eh)) {
+      return false;
+    }
+    memcpy(&eh, image, sizeof(eh));
+    shoff = (size_t)eh.e_shoff; shentsize = eh.e_shentsize; shnum = eh.e_shnum; shstrndx = eh.e_shstrndx;
+  }
+  else {
+    Elf32_Ehdr eh;
+    if (image_size < sizeof(eh)) {
+      return false;
+    }
+    memcpy(&eh, image, sizeof(eh));
+    shoff = eh.e_shoff; shentsize = eh.e_shentsize; shnum = eh.e_shnum; shstrndx = eh.e_shstrndx;
+  }
+  if ((shstrndx >= shnum) || (shentsize < (is64 ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr))) ||
+      (shoff > image_size) || (shnum > (image_size - shoff) / shentsize)) {
+    return false;
+  }
+
+  // section name string table
+  dict_section_type names;
+  _dict_section(image, is64, shoff, shentsize, shstrndx, &names);
+  if ((names.offset > image_size) || (names.size > image_size - names.offset)) {
+    return false;
+  }
+
+  for (size_t i = 0U; i < shnum; ++i) {
+    _dict_section(image, is64, shoff, shentsize, i, section);
+    if ((section->name < names.size) && (names.size - section->name >= sizeof(PRINTF_DICT_SECTION)) &&
+        !memcmp(image + names.offset + section->name, PRINTF_DICT_SECTION, sizeof(PRINTF_DICT_SECTION))) {
+      return (section->offset <= image_size) && (section->size <= image_size - section->offset);
+    }
+  }
+  return false;
+}
+
+
+/**
+ * Load the format string dictionary from a firmware ELF image
+ * \param path Path of the ELF image
+ * \param size Receives the size of the dictionary
+ * \return malloc'ed copy of the dictionary section, NULL if the image can't be read or has no dictionary
+ */
+char* printf_dict_load(const char* path, size_t* size)
+{
+  size_t image_size = 0U;
+  dict_section_type section;
+  unsigned char* image = _dict_read_file(path, &image_size);
+  char* dict = NULL;
+  if (image && _dict_find_section(image, image_size, &section)) {
+    // append a NUL, so a truncated last string is still terminated
+    dict = (char*)malloc(section.size + 1U);
+    if (dict) {
+      memcpy(dict, image + section.offset, section.size);
+      dict[section.size] = 0;
+      *size = section.size;
+    }
+  }
+  free(image);
+  return dict;
+}
+
+
+/**
+ * Look up a format string in the dictionary
+ * \param dict The dictionary as returned by printf_dict_load()
+ * \param size The size of the dictionary
+ * \param id The ID (section offset) of the format string
+ * \return The format string, NULL if 'id' is not the start of a format string
+ */
+const char* printf_dict_lookup(const char* dict, size_t size, uintptr_t id)
+{
+  if ((id >= size) || !dict[id] || (id && dict[id - 1U])) {
+    return NULL;
+  }
+  return dict + id;
+}
+
+
+#if !defined(PRINTF_DICT_NO_MAIN)
+
+#include "../printf.h"
+
+
+// printf.h maps printf() to printf_(), the tool prints with fprintf() instead
+void _putchar(char character)
+{
+  putchar(character);
+}
+
+
+// internal print of a format string with C escapes
+static void _dict_print_escaped(const char* str)
+{
+  for (; *str; ++str) {
+    switch (*str) {
+      case '\n': fputs("\\n", stdout);  break;
+      case '\r': fputs("\\r", stdout);  break;
+      case '\t': fputs("\\t", stdout);  break;
+      case '\\': fputs("\\\\", stdout); break;
+      default  : putchar(*str);         break;
+    }
+  }
+}
+
+
+// internal decode of one hex encoded record
+static void _dict_decode(const char* dict, size_t size, const char* line)
+{
+  unsigned char record[1024];
+  size_t len = 0U;
+  unsigned int byte;
+  while ((len < sizeof(record)) && (sscanf(line, "%2x", &byte) == 1)) {
+    record[len++] = (unsigned char)byte;
+    line += 2;
+  }
+
+  uintptr_t id;
+  const size_t header = binheader(record, len, &id);
+  const char*  format = printf_dict_lookup(dict, size, id);
+  if (!format) {
+    fprintf(stdout, "<unknown format ID %lu>\n", (unsigned long)id);
+    return;
+  }
+  char text[4096];
+  binsnprintf(text, sizeof(text), format, record + header, len - header);
+  fputs(text, stdout);
+}
+
+
+int main(int argc, char* argv[])
+{
+  if ((argc != 2) && (argc != 3)) {
+    fprintf(stderr, "usage: %s <firmware.elf> [-]\n", argv[0]);
+    return 2;
+  }
+
+  size_t size = 0U;
+  char* dict = printf_dict_load(argv[1], &size);
+  if (!dict) {
+    fprintf(stderr, "%s: no " PRINTF_DICT_SECTION " section\n", argv[1]);
+    return 1;
+  }
+
+  if (argc == 2) {
+    // print the dictionary, skipping alignment padding between the strings
+    for (size_t id = 0U; id < size; ++id) {
+      if (dict[id]) {
+        fprintf(stdout, "%lu\t", (unsigned long)id);
+        _dict_print_escaped(dict + id);
+        putchar('\n');
+        id += strlen(dict + id);
+      }
+    }
+  }
+  else {
+    char line[2 * 1024 + 2];
+    while (fgets(line, sizeof(line), stdin)) {
+      _dict_decode(dict, size, line);
+    }
+  }
+
+  free(dict);
+  return 0;
+}
+
+#endif  // PRINTF_DICT_NO_MAIN